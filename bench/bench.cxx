@@ -0,0 +1,467 @@
+#include "itertools.hxx"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace bench {
+    /**
+     * @brief Large element type spanning a whole cache line
+     */
+    struct Large {
+        size_t id;
+        double payload[7];
+
+        bool operator==(Large const &other) const { return id == other.id; }
+    };
+} // namespace bench
+
+/**
+ * @brief Hash of the large element type used by collectInsert
+ */
+template <>
+struct std::hash<bench::Large> {
+    size_t operator()(bench::Large const &value) const { return std::hash<size_t>()(value.id); }
+};
+
+namespace bench {
+    /**
+     * @brief Prevent the compiler from optimizing away the computation of a value
+     * @param value Value to keep
+     */
+    template <typename ValueType>
+    void doNotOptimize(ValueType const &value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    /**
+     * @brief Element type specific input generation and key extraction
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    struct Traits;
+
+    template <>
+    struct Traits<int> {
+        static constexpr char const *Name = "int";
+        static constexpr bool Arithmetic = true;
+        static int make(size_t i) { return static_cast<int>(i % 1000); }
+        static int factor(size_t i) { return i % 3 == 0 ? -1 : 1; }
+        static size_t key(int const &value) { return static_cast<size_t>(value); }
+    };
+
+    template <>
+    struct Traits<double> {
+        static constexpr char const *Name = "double";
+        static constexpr bool Arithmetic = true;
+        static double make(size_t i) { return static_cast<double>(i % 1000) * 0.5; }
+        static double factor(size_t i) { return 1.0 + (static_cast<double>(i % 7) - 3.0) * 1e-9; }
+        static size_t key(double const &value) { return static_cast<size_t>(value); }
+    };
+
+    template <>
+    struct Traits<std::string> {
+        static constexpr char const *Name = "string";
+        static constexpr bool Arithmetic = false;
+        static std::string make(size_t i) { return "element-" + std::to_string(i); }
+        static size_t key(std::string const &value) { return value.size() + static_cast<size_t>(value.back()); }
+    };
+
+    template <>
+    struct Traits<Large> {
+        static constexpr char const *Name = "large";
+        static constexpr bool Arithmetic = false;
+        static Large make(size_t i) { return Large{i, {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5}}; }
+        static size_t key(Large const &value) { return value.id; }
+    };
+
+    /**
+     * @brief Options of a benchmark run
+     */
+    struct Options {
+        size_t minSize = 1000;
+        size_t maxSize = 1000000;
+        double minTime = 0.1;
+        std::string caseFilter;
+        std::string typeFilter;
+        std::string output;
+    };
+
+    /**
+     * @brief Measures benchmark cases and collects the results
+     */
+    class Runner {
+      public:
+        /**
+         * @brief Create a new runner
+         * @param options Options of the run
+         */
+        Runner(Options const &options) : m_options(options) {}
+
+        /**
+         * @brief Check whether a case of an element type is selected by the filters
+         * @param name Name of the case
+         * @param type Name of the element type
+         * @return True if selected, false otherwise
+         */
+        bool selected(std::string const &name, std::string const &type) const {
+            return name.find(m_options.caseFilter) != std::string::npos &&
+                   type.find(m_options.typeFilter) != std::string::npos;
+        }
+
+        /**
+         * @brief Measure a single variant of a case
+         * @details The function is repeated until the minimal time is reached, but at least three times.
+         * @param name Name of the case
+         * @param type Name of the element type
+         * @param size Number of input elements
+         * @param variant Name of the implementation variant
+         * @param function Function executing the variant once
+         */
+        template <typename Function>
+        void measure(std::string const &name, std::string const &type, size_t size, std::string const &variant,
+                     Function function) {
+            using Clock = std::chrono::steady_clock;
+            doNotOptimize(function());
+            size_t iterations = 0;
+            double total = 0.0;
+            double best = 0.0;
+            while (iterations < 3 || total < m_options.minTime) {
+                Clock::time_point start = Clock::now();
+                doNotOptimize(function());
+                double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                best = iterations == 0 ? elapsed : std::min(best, elapsed);
+                total += elapsed;
+                ++iterations;
+            }
+            Result result{name, type, size, variant, iterations, best * 1e9 / static_cast<double>(size),
+                          total * 1e9 / static_cast<double>(size * iterations)};
+            std::cerr << name << "/" << type << "/" << size << "/" << variant << ": " << result.nsPerElementMin
+                      << " ns/element" << std::endl;
+            m_results.push_back(result);
+        }
+
+        /**
+         * @brief Write all results as JSON
+         * @param stream Stream to write to
+         */
+        void writeJson(std::ostream &stream) const {
+            stream << "{\n  \"benchmarks\": [";
+            for (size_t i = 0; i < m_results.size(); ++i) {
+                Result const &r = m_results[i];
+                stream << (i == 0 ? "\n" : ",\n") << "    {\"case\": \"" << r.name << "\", \"type\": \"" << r.type
+                       << "\", \"size\": " << r.size << ", \"variant\": \"" << r.variant
+                       << "\", \"iterations\": " << r.iterations << ", \"ns_per_element_min\": " << r.nsPerElementMin
+                       << ", \"ns_per_element_mean\": " << r.nsPerElementMean << "}";
+            }
+            stream << "\n  ]\n}\n";
+        }
+
+      private:
+        /**
+         * @brief Result of a single measured variant
+         */
+        struct Result {
+            std::string name;
+            std::string type;
+            size_t size;
+            std::string variant;
+            size_t iterations;
+            double nsPerElementMin;
+            double nsPerElementMean;
+        };
+
+        // Options of the run
+        Options m_options;
+        // Collected results
+        std::vector<Result> m_results;
+    };
+
+    /**
+     * @brief Run all cases of an element type and input size
+     * @typeparam ValueType Type of the elements
+     * @param runner Runner measuring the cases
+     * @param size Number of input elements
+     */
+    template <typename ValueType>
+    void runType(Runner &runner, size_t size) {
+        using T = Traits<ValueType>;
+        std::string type = T::Name;
+        std::vector<ValueType> v;
+        v.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            v.push_back(T::make(i));
+        }
+        std::vector<int> index(size);
+        for (size_t i = 0; i < size; ++i) {
+            index[i] = static_cast<int>(i);
+        }
+        auto key = [](ValueType &value) { return T::key(value); };
+        auto pred = [](ValueType &value) { return T::key(value) % 2 == 0; };
+
+        if (runner.selected("map", type)) {
+            runner.measure("map", type, size, "itertools", [&]() {
+                return itertools::Iterator::from(v).template map<size_t>(key).sum().get();
+            });
+            runner.measure("map", type, size, "fuse",
+                           [&]() { return itertools::Iterator::fuse(v).map(key).sum().get(); });
+            runner.measure("map", type, size, "loop", [&]() {
+                size_t s = 0;
+                for (ValueType &value : v) {
+                    s += T::key(value);
+                }
+                return s;
+            });
+            runner.measure("map", type, size, "ranges", [&]() {
+                size_t s = 0;
+                for (size_t value : v | std::views::transform(key)) {
+                    s += value;
+                }
+                return s;
+            });
+        }
+
+        if (runner.selected("filter", type)) {
+            runner.measure("filter", type, size, "itertools", [&]() {
+                return itertools::Iterator::from(v).filter(pred).template collectPush<std::vector<ValueType>>().size();
+            });
+            runner.measure("filter", type, size, "fuse", [&]() {
+                return itertools::Iterator::fuse(v).filter(pred).template collectPush<std::vector<ValueType>>().size();
+            });
+            runner.measure("filter", type, size, "loop", [&]() {
+                std::vector<ValueType> out;
+                for (ValueType &value : v) {
+                    if (pred(value)) {
+                        out.push_back(value);
+                    }
+                }
+                return out.size();
+            });
+            runner.measure("filter", type, size, "ranges", [&]() {
+                std::vector<ValueType> out;
+                for (ValueType &value : v | std::views::filter(pred)) {
+                    out.push_back(value);
+                }
+                return out.size();
+            });
+        }
+
+        if (runner.selected("zip", type)) {
+            using Pair = std::pair<ValueType, int>;
+            runner.measure("zip", type, size, "itertools", [&]() {
+                return itertools::Iterator::from(v)
+                    .template zip<int>(itertools::Iterator::from(index).into())
+                    .template collectPush<std::vector<Pair>>()
+                    .size();
+            });
+            runner.measure("zip", type, size, "fuse", [&]() {
+                return itertools::Iterator::fuse(v)
+                    .zip(itertools::Iterator::fuse(index))
+                    .template collectPush<std::vector<Pair>>()
+                    .size();
+            });
+            runner.measure("zip", type, size, "loop", [&]() {
+                std::vector<Pair> out;
+                out.reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    out.emplace_back(v[i], index[i]);
+                }
+                return out.size();
+            });
+            runner.measure("zip", type, size, "ranges", [&]() {
+                auto r = std::views::iota(size_t(0), size) |
+                         std::views::transform([&](size_t i) { return Pair(v[i], index[i]); });
+                std::vector<Pair> out(r.begin(), r.end());
+                return out.size();
+            });
+        }
+
+        if (runner.selected("enumerate", type)) {
+            using Pair = std::pair<size_t, ValueType>;
+            runner.measure("enumerate", type, size, "itertools", [&]() {
+                return itertools::Iterator::from(v).enumerate().template collectPush<std::vector<Pair>>().size();
+            });
+            runner.measure("enumerate", type, size, "fuse", [&]() {
+                return itertools::Iterator::fuse(v).enumerate().template collectPush<std::vector<Pair>>().size();
+            });
+            runner.measure("enumerate", type, size, "loop", [&]() {
+                std::vector<Pair> out;
+                out.reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    out.emplace_back(i, v[i]);
+                }
+                return out.size();
+            });
+            runner.measure("enumerate", type, size, "ranges", [&]() {
+                auto r = std::views::iota(size_t(0), size) |
+                         std::views::transform([&](size_t i) { return Pair(i, v[i]); });
+                std::vector<Pair> out(r.begin(), r.end());
+                return out.size();
+            });
+        }
+
+        if constexpr (T::Arithmetic) {
+            // Integers wrap around like in the kernels, instead of overflowing the signed type
+            using Arithmetic = itertools::kernels::ArithmeticType<ValueType>;
+            if (runner.selected("sum", type)) {
+                runner.measure("sum", type, size, "itertools",
+                               [&]() { return itertools::Iterator::from(v).sum().get(); });
+                runner.measure("sum", type, size, "fuse", [&]() { return itertools::Iterator::fuse(v).sum().get(); });
+                runner.measure("sum", type, size, "loop", [&]() {
+                    Arithmetic s = v[0];
+                    for (size_t i = 1; i < size; ++i) {
+                        s += static_cast<Arithmetic>(v[i]);
+                    }
+                    return static_cast<ValueType>(s);
+                });
+                runner.measure("sum", type, size, "ranges", [&]() {
+                    Arithmetic s = Arithmetic();
+                    for (ValueType value : v | std::views::all) {
+                        s += static_cast<Arithmetic>(value);
+                    }
+                    return static_cast<ValueType>(s);
+                });
+            }
+
+            if (runner.selected("product", type)) {
+                std::vector<ValueType> f;
+                f.reserve(size);
+                for (size_t i = 0; i < size; ++i) {
+                    f.push_back(T::factor(i));
+                }
+                runner.measure("product", type, size, "itertools",
+                               [&]() { return itertools::Iterator::from(f).product().get(); });
+                runner.measure("product", type, size, "fuse",
+                               [&]() { return itertools::Iterator::fuse(f).product().get(); });
+                runner.measure("product", type, size, "loop", [&]() {
+                    Arithmetic p = f[0];
+                    for (size_t i = 1; i < size; ++i) {
+                        p *= static_cast<Arithmetic>(f[i]);
+                    }
+                    return static_cast<ValueType>(p);
+                });
+                runner.measure("product", type, size, "ranges", [&]() {
+                    Arithmetic p = Arithmetic(1);
+                    for (ValueType value : f | std::views::all) {
+                        p *= static_cast<Arithmetic>(value);
+                    }
+                    return static_cast<ValueType>(p);
+                });
+            }
+        }
+
+        if (runner.selected("collectPush", type)) {
+            runner.measure("collectPush", type, size, "itertools", [&]() {
+                return itertools::Iterator::from(v).template collectPush<std::vector<ValueType>>().size();
+            });
+            runner.measure("collectPush", type, size, "fuse", [&]() {
+                return itertools::Iterator::fuse(v).template collectPush<std::vector<ValueType>>().size();
+            });
+            runner.measure("collectPush", type, size, "loop", [&]() {
+                std::vector<ValueType> out;
+                out.reserve(size);
+                for (ValueType &value : v) {
+                    out.push_back(value);
+                }
+                return out.size();
+            });
+            runner.measure("collectPush", type, size, "ranges", [&]() {
+                auto r = v | std::views::all;
+                std::vector<ValueType> out(r.begin(), r.end());
+                return out.size();
+            });
+        }
+
+        if (runner.selected("collectInsert", type)) {
+            using Set = std::unordered_set<ValueType>;
+            runner.measure("collectInsert", type, size, "itertools",
+                           [&]() { return itertools::Iterator::from(v).template collectInsert<Set>().size(); });
+            runner.measure("collectInsert", type, size, "fuse",
+                           [&]() { return itertools::Iterator::fuse(v).template collectInsert<Set>().size(); });
+            runner.measure("collectInsert", type, size, "loop", [&]() {
+                Set out;
+                out.reserve(size);
+                for (ValueType &value : v) {
+                    out.insert(value);
+                }
+                return out.size();
+            });
+            runner.measure("collectInsert", type, size, "ranges", [&]() {
+                auto r = v | std::views::all;
+                Set out(r.begin(), r.end());
+                return out.size();
+            });
+        }
+    }
+
+    /**
+     * @brief Print the usage of the benchmark
+     * @param name Name of the executable
+     */
+    void usage(char const *name) {
+        std::cerr << "Usage: " << name << " [options]\n"
+                  << "  --min-size N   Smallest input size, default 1000\n"
+                  << "  --max-size N   Largest input size, default 1000000, sizes grow by factor 10\n"
+                  << "  --min-time S   Minimal measured time per variant in seconds, default 0.1\n"
+                  << "  --case NAME    Only run cases containing NAME\n"
+                  << "  --type NAME    Only run element types containing NAME\n"
+                  << "  --output FILE  Write the JSON results to FILE instead of stdout\n";
+    }
+} // namespace bench
+
+int main(int argc, char *argv[]) {
+    bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help") {
+            bench::usage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            bench::usage(argv[0]);
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--min-size") {
+            options.minSize = std::stoull(value);
+        } else if (arg == "--max-size") {
+            options.maxSize = std::stoull(value);
+        } else if (arg == "--min-time") {
+            options.minTime = std::stod(value);
+        } else if (arg == "--case") {
+            options.caseFilter = value;
+        } else if (arg == "--type") {
+            options.typeFilter = value;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            bench::usage(argv[0]);
+            return 1;
+        }
+    }
+
+    bench::Runner runner(options);
+    for (size_t size = std::max<size_t>(options.minSize, 1); size <= options.maxSize; size *= 10) {
+        bench::runType<int>(runner, size);
+        bench::runType<double>(runner, size);
+        bench::runType<std::string>(runner, size);
+        bench::runType<bench::Large>(runner, size);
+    }
+
+    if (options.output.empty()) {
+        runner.writeJson(std::cout);
+    } else {
+        std::ofstream file(options.output);
+        runner.writeJson(file);
+    }
+    return 0;
+}
@@ -0,0 +1,463 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_ASYNC_HXX_
+#define _ITERTOOLS_ASYNC_HXX_
+
+#include "optional.hxx"
+#include "types.hxx"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itertools {
+    /**
+     * @brief Backoff strategy of threads waiting on a ring buffer
+     * @details Yields the first attempts and sleeps afterwards, so waiting threads don't burn a core.
+     */
+    class Backoff {
+      public:
+        /**
+         * @brief Number of attempts yielding before sleeping
+         */
+        static constexpr size_t SpinCount = 64;
+
+        /**
+         * @brief Wait before the next attempt
+         */
+        void wait() {
+            if (m_attempts++ < SpinCount) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+
+      private:
+        // Number of attempts so far
+        size_t m_attempts = 0;
+    };
+
+    /**
+     * @brief Bounded lock-free single-producer single-consumer ring buffer
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class RingBuffer {
+      public:
+        /**
+         * @brief Create a new ring buffer
+         * @param capacity Minimal number of elements, rounded up to the next power of two
+         */
+        RingBuffer(size_t capacity) : m_head(0), m_tail(0), m_closed(false) {
+            size_t size = 1;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            m_slots.resize(size);
+            m_mask = size - 1;
+        }
+
+        RingBuffer(RingBuffer const &) = delete;
+        RingBuffer &operator=(RingBuffer const &) = delete;
+
+        /**
+         * @brief Move an element into the buffer if it isn't full
+         * @param value Element to move, unchanged if the buffer is full
+         * @return True if the element was pushed, false otherwise
+         */
+        bool tryPush(ValueType &value) {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+                return false;
+            }
+            m_slots[tail & m_mask] = std::move(value);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Move an element out of the buffer if it isn't empty
+         * @param value Element to move into
+         * @return True if an element was popped, false otherwise
+         */
+        bool tryPop(ValueType &value) {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            value = std::move(m_slots[head & m_mask]);
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Move an element into the buffer, waiting while it is full
+         * @param value Element to move
+         * @param cancelled Flag to stop waiting
+         * @return True if the element was pushed, false if cancelled
+         */
+        bool push(ValueType &value, std::atomic<bool> const &cancelled) {
+            Backoff backoff;
+            while (!tryPush(value)) {
+                if (cancelled.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                backoff.wait();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Move an element out of the buffer, waiting while it is empty and not closed
+         * @param value Element to move into
+         * @return True if an element was popped, false if the buffer is closed and empty
+         */
+        bool pop(ValueType &value) {
+            Backoff backoff;
+            while (!tryPop(value)) {
+                if (closed()) {
+                    return tryPop(value);
+                }
+                backoff.wait();
+            }
+            return true;
+        }
+
+        /**
+         * @brief Mark the end of the elements, called by the producer after its last push
+         */
+        void close() { m_closed.store(true, std::memory_order_release); }
+
+        /**
+         * @brief Check whether the producer has pushed its last element
+         * @return True if closed, false otherwise
+         */
+        bool closed() const { return m_closed.load(std::memory_order_acquire); }
+
+      private:
+        // Slots of the elements
+        std::vector<ValueType> m_slots;
+        // Mask to map positions to slots
+        size_t m_mask;
+        // Position of the next element to pop, only written by the consumer
+        alignas(64) std::atomic<size_t> m_head;
+        // Position of the next element to push, only written by the producer
+        alignas(64) std::atomic<size_t> m_tail;
+        // Whether the producer has pushed its last element
+        alignas(64) std::atomic<bool> m_closed;
+    };
+
+    /**
+     * @brief Iterator running its upstream chain on separate threads
+     * @details The upstream chain is pulled in batches by a dedicated producer thread and handed over through bounded
+     * ring buffers. A full ring blocks the producer, so at most capacity batches are buffered. Dedicated threads are
+     * used instead of the ThreadPool, since the producers block for the whole lifetime of the iterator. Elements must
+     * stay valid after the next pull from the upstream chain, i.e. file sources must be memory mapped. Exceptions of
+     * the upstream chain or the mapping are rethrown by the consuming thread.
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class AsyncIterator : public IIterator<ValueType> {
+      public:
+        /**
+         * @brief Number of elements per batch handed over between threads
+         */
+        static constexpr size_t BatchSize = 1024;
+
+        /**
+         * @brief Default number of batches buffered per ring
+         */
+        static constexpr size_t DefaultCapacity = 8;
+
+        /**
+         * @brief Run the parent on its own thread
+         * @param parent Parent iterator
+         * @param capacity Number of batches buffered between the threads
+         */
+        AsyncIterator(std::shared_ptr<IIterator<ValueType>> parent, size_t capacity = DefaultCapacity)
+            : m_hint(parent->sizeHint()), m_ordered(true), m_cancelled(false) {
+            m_parentStats = [parent](StatsReport &report) { return parent->collectStats(report); };
+            m_outputs.push_back(std::make_unique<RingBuffer<Batch<ValueType>>>(capacity));
+            m_threads.emplace_back([this, parent]() {
+                RingBuffer<Batch<ValueType>> &output = *m_outputs[0];
+                try {
+                    Batch<ValueType> batch;
+                    while (!m_cancelled.load(std::memory_order_acquire) && parent->nextBatch(batch, BatchSize) != 0) {
+                        if (!output.push(batch, m_cancelled)) {
+                            break;
+                        }
+                        batch = Batch<ValueType>();
+                    }
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                output.close();
+            });
+        }
+
+        /**
+         * @brief Map the elements of the parent on several worker threads
+         * @details The parent is pulled by a dispatcher thread which hands the batches round-robin to the workers. If
+         * ordered, the batches are consumed in the same round-robin order, which restores the order of the parent.
+         * Otherwise, batches are consumed as soon as any worker has finished them. The mapping is called concurrently
+         * and must be thread-safe.
+         * @typeparam InputType Type of the elements of the parent
+         * @param parent Parent iterator
+         * @param map Mapping to apply to each element
+         * @param workers Number of worker threads
+         * @param ordered Whether to keep the order of the parent
+         * @param capacity Number of batches buffered per worker
+         */
+        template <typename InputType>
+        AsyncIterator(std::shared_ptr<IIterator<InputType>> parent, std::function<ValueType(InputType &)> map,
+                      size_t workers, bool ordered = true, size_t capacity = DefaultCapacity)
+            : m_hint(parent->sizeHint()), m_ordered(ordered), m_cancelled(false) {
+            m_parentStats = [parent](StatsReport &report) { return parent->collectStats(report); };
+            workers = std::max<size_t>(workers, 1);
+            auto inputs = std::make_shared<std::vector<std::unique_ptr<RingBuffer<Batch<InputType>>>>>();
+            for (size_t i = 0; i < workers; ++i) {
+                inputs->push_back(std::make_unique<RingBuffer<Batch<InputType>>>(capacity));
+                m_outputs.push_back(std::make_unique<RingBuffer<Batch<ValueType>>>(capacity));
+            }
+            m_threads.emplace_back([this, parent, inputs]() {
+                try {
+                    Batch<InputType> batch;
+                    for (size_t i = 0;
+                         !m_cancelled.load(std::memory_order_acquire) && parent->nextBatch(batch, BatchSize) != 0;
+                         ++i) {
+                        if (!(*inputs)[i % inputs->size()]->push(batch, m_cancelled)) {
+                            break;
+                        }
+                        batch = Batch<InputType>();
+                    }
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+                for (auto &input : *inputs) {
+                    input->close();
+                }
+            });
+            for (size_t i = 0; i < workers; ++i) {
+                m_threads.emplace_back([this, map, inputs, i]() {
+                    RingBuffer<Batch<InputType>> &input = *(*inputs)[i];
+                    RingBuffer<Batch<ValueType>> &output = *m_outputs[i];
+                    try {
+                        Batch<InputType> batch;
+                        while (input.pop(batch)) {
+                            Batch<ValueType> mapped;
+                            mapped.reserve(batch.size());
+                            for (InputType &value : batch) {
+                                mapped.push_back(map(value));
+                            }
+                            if (!output.push(mapped, m_cancelled)) {
+                                break;
+                            }
+                        }
+                    } catch (...) {
+                        fail(std::current_exception());
+                    }
+                    output.close();
+                });
+            }
+        }
+
+        AsyncIterator(AsyncIterator const &) = delete;
+        AsyncIterator &operator=(AsyncIterator const &) = delete;
+
+        /**
+         * @brief Stop and join all threads
+         */
+        ~AsyncIterator() {
+            m_cancelled.store(true, std::memory_order_release);
+            for (std::thread &thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        /**
+         * @brief Get the next element handed over by the producers
+         * @return Next element or None if the end is reached
+         */
+        Option<ValueType> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            if (m_position == m_batch.size() && !fetch()) {
+                return Option<ValueType>();
+            }
+            m_stats.pulled(1);
+            m_stats.yielded(1);
+            ++m_yielded;
+            if constexpr (std::is_reference_v<ValueType>) {
+                return Option<ValueType>(m_batch[m_position++].get());
+            } else {
+                return Option<ValueType>(std::move(m_batch[m_position++]));
+            }
+        }
+
+        /**
+         * @brief Append the next elements handed over by the producers to the given buffer
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<ValueType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (maxCount == 0 || (m_position == m_batch.size() && !fetch())) {
+                return 0;
+            }
+            size_t count = std::min(maxCount, m_batch.size() - m_position);
+            if (buffer.empty() && m_position == 0 && count == m_batch.size()) {
+                buffer.swap(m_batch);
+                m_batch.clear();
+            } else {
+                auto begin = m_batch.begin() + static_cast<std::ptrdiff_t>(m_position);
+                buffer.insert(buffer.end(), std::make_move_iterator(begin),
+                              std::make_move_iterator(begin + static_cast<std::ptrdiff_t>(count)));
+                m_position += count;
+            }
+            m_stats.pulled(count);
+            m_stats.yielded(count);
+            m_yielded += count;
+            return count;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent at construction reduced by the yielded elements
+         */
+        SizeHint sizeHint() const override {
+            size_t lower = m_hint.lower() > m_yielded ? m_hint.lower() - m_yielded : 0;
+            Option<size_t> upper = m_hint.upper();
+            if (upper.isSome()) {
+                upper = Option<size_t>(upper.get() > m_yielded ? upper.get() - m_yielded : 0);
+            }
+            return SizeHint(lower, upper);
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @details The parents are updated by other threads, so their statistics are only consistent at the end.
+         * @param report Report to append to
+         * @return Estimated time spent waiting for and consuming the handed over elements
+         */
+        double collectStats(StatsReport &report) const override {
+            m_parentStats(report);
+            return m_stats.report(report, "async", 0.0);
+        }
+
+      private:
+        /**
+         * @brief Record the first exception of any thread and stop all threads
+         * @param exception Exception to record
+         */
+        void fail(std::exception_ptr exception) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_exception) {
+                    m_exception = exception;
+                }
+            }
+            m_cancelled.store(true, std::memory_order_release);
+        }
+
+        /**
+         * @brief Replace the current batch by the next batch of the producers
+         * @details Producers never hand over empty batches. Rethrows the first exception of any thread once all
+         * producers are done.
+         * @return True if a batch was fetched, false if the end is reached
+         */
+        bool fetch() {
+            m_batch.clear();
+            m_position = 0;
+            bool fetched = false;
+            if (m_ordered) {
+                fetched = m_outputs[m_current]->pop(m_batch);
+                m_current = (m_current + 1) % m_outputs.size();
+            } else {
+                Backoff backoff;
+                bool open = true;
+                while (!fetched && open) {
+                    open = false;
+                    for (size_t i = 0; i < m_outputs.size() && !fetched; ++i) {
+                        RingBuffer<Batch<ValueType>> &output = *m_outputs[(m_current + i) % m_outputs.size()];
+                        bool closed = output.closed();
+                        fetched = output.tryPop(m_batch);
+                        open = open || !closed;
+                    }
+                    m_current = (m_current + 1) % m_outputs.size();
+                    if (!fetched && open) {
+                        backoff.wait();
+                    }
+                }
+            }
+            if (!fetched) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_exception) {
+                    std::exception_ptr exception = m_exception;
+                    m_exception = nullptr;
+                    std::rethrow_exception(exception);
+                }
+            }
+            return fetched;
+        }
+
+        // Rings handing over the batches of the producers
+        std::vector<std::unique_ptr<RingBuffer<Batch<ValueType>>>> m_outputs;
+        // Producer threads
+        std::vector<std::thread> m_threads;
+        // Current batch
+        Batch<ValueType> m_batch;
+        // Position of the next element in the current batch
+        size_t m_position = 0;
+        // Index of the ring to fetch the next batch from
+        size_t m_current = 0;
+        // Number of yielded elements
+        size_t m_yielded = 0;
+        // Bounds of the number of elements of the parent at construction
+        SizeHint m_hint;
+        // Whether to fetch the batches in round-robin order
+        bool m_ordered;
+        // Flag to stop all threads
+        std::atomic<bool> m_cancelled;
+        // Mutex protecting the exception
+        std::mutex m_mutex;
+        // First exception thrown by any thread
+        std::exception_ptr m_exception;
+        // Statistics of the parents
+        std::function<double(StatsReport &)> m_parentStats;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+} // namespace itertools
+
+#endif
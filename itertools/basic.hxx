@@ -25,24 +25,26 @@
 
 #include "optional.hxx"
 #include "types.hxx"
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace itertools {
     /**
      * @brief Basic iterator class iterating over a container
+     * @details If ValueType is a reference, the elements are borrowed from the container instead of copied. If the
+     * iterator owns the container, the elements are moved out of it.
      * @typeparam Container Container type
+     * @typeparam ValueType Type of the yielded elements
      */
-    template <typename Container>
-    class BasicIterator : public IIterator<typename Container::value_type>,
-                          public std::enable_shared_from_this<BasicIterator<Container>> {
+    template <typename Container, typename ValueType>
+    class BasicIterator : public IIterator<ValueType>,
+                          public std::enable_shared_from_this<BasicIterator<Container, ValueType>> {
       public:
-        /**
-         * @brief Value type of the elements in the container
-         */
-        using ValueType = typename Container::value_type;
-
         /**
          * @brief Container iterator type
          */
@@ -54,6 +56,14 @@ namespace itertools {
          */
         BasicIterator(Container &container) : m_begin(container.begin()), m_end(container.end()) {}
 
+        /**
+         * @brief Create a new iterator taking ownership of a container
+         * @param container Container to consume
+         */
+        BasicIterator(Container &&container)
+            : m_owned(std::make_unique<Container>(std::move(container))), m_begin(m_owned->begin()),
+              m_end(m_owned->end()) {}
+
         /**
          * @brief Delete the BasicIterator object
          */
@@ -64,15 +74,104 @@ namespace itertools {
          * @return Next element in the container or None if the end is reached
          */
         Option<ValueType> next() override {
+            StageCounter::Scope scope = m_stats.next();
             if (m_begin != m_end) {
-                Option<ValueType> opt = Option<ValueType>(*m_begin);
-                ++m_begin;
-                return opt;
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+                if constexpr (!std::is_reference_v<ValueType>) {
+                    if (m_owned) {
+                        return Option<ValueType>(std::move(*m_begin++));
+                    }
+                }
+                return Option<ValueType>(*m_begin++);
             } else {
                 return Option<ValueType>();
             }
         }
 
+        /**
+         * @brief Get the next elements of the container as a slice without copying them
+         * @param maxCount Maximum number of elements in the slice
+         * @return Begin and end of the slice, empty if the end is reached
+         */
+        std::pair<ContainerIter, ContainerIter> nextSlice(size_t maxCount) {
+            ContainerIter begin = m_begin;
+            size_t count = 0;
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<ContainerIter>::iterator_category>) {
+                count = std::min(maxCount, static_cast<size_t>(m_end - m_begin));
+                m_begin += count;
+            } else {
+                for (; count < maxCount && m_begin != m_end; ++count) {
+                    ++m_begin;
+                }
+            }
+            m_stats.pulled(count);
+            m_stats.yielded(count);
+            return std::make_pair(begin, m_begin);
+        }
+
+        /**
+         * @brief Append the next elements of the container to the given buffer
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<ValueType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            size_t size = buffer.size();
+            std::pair<ContainerIter, ContainerIter> slice = nextSlice(maxCount);
+            if constexpr (!std::is_reference_v<ValueType>) {
+                if (m_owned) {
+                    buffer.insert(buffer.end(), std::make_move_iterator(slice.first),
+                                  std::make_move_iterator(slice.second));
+                    return buffer.size() - size;
+                }
+            }
+            buffer.insert(buffer.end(), slice.first, slice.second);
+            return buffer.size() - size;
+        }
+
+        /**
+         * @brief Skip the next elements without copying them
+         * @details Random access containers are advanced in constant time.
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override {
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<ContainerIter>::iterator_category>) {
+                size_t skipped = std::min(count, static_cast<size_t>(m_end - m_begin));
+                m_begin += skipped;
+                return skipped;
+            } else {
+                size_t skipped = 0;
+                for (; skipped < count && m_begin != m_end; ++skipped) {
+                    ++m_begin;
+                }
+                return skipped;
+            }
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Exact number of remaining elements for random access containers
+         */
+        SizeHint sizeHint() const override {
+            if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<ContainerIter>::iterator_category>) {
+                return SizeHint::exact(static_cast<size_t>(m_end - m_begin));
+            }
+            return SizeHint();
+        }
+
+        /**
+         * @brief Append the statistics of this iterator to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator
+         */
+        double collectStats(StatsReport &report) const override { return m_stats.report(report, "basic", 0.0); }
+
         /**
          * @brief Zip iterator with another iterator
          * @typeparam OutputType Output type of the other iterator
@@ -114,10 +213,14 @@ namespace itertools {
         }
 
       private:
+        // Container owned by the iterator, nullptr if the container is borrowed
+        std::unique_ptr<Container> m_owned;
         // Start of the container
         ContainerIter m_begin;
         // End of the container
         ContainerIter const m_end;
+        // Statistics of the iterator
+        StageCounter m_stats;
     };
 
 } // namespace itertools
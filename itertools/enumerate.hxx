@@ -28,6 +28,7 @@
 #include <iostream>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace itertools {
 
@@ -56,17 +57,76 @@ namespace itertools {
          * @return Next element of zipped iterator.
          */
         Option<OutputPairType> next() override {
+            StageCounter::Scope scope = m_stats.next();
             while (m_parent) {
                 Option<OutputType> p = m_parent->next();
                 if (p.isNone()) {
                     return Option<OutputPairType>();
                 } else {
-                    return Option<OutputPairType>(std::make_pair(m_index++, p.get()));
+                    m_stats.pulled(1);
+                    m_stats.yielded(1);
+                    return Option<OutputPairType>(OutputPairType(m_index++, std::forward<OutputType>(p.get())));
                 }
             }
             return Option<OutputPairType>();
         }
 
+        /**
+         * @brief Append the next enumerated elements to the given buffer
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<OutputPairType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (m_parent) {
+                m_batch.clear();
+                size_t count = m_parent->nextBatch(m_batch, maxCount);
+                for (OutputType &value : m_batch) {
+                    buffer.emplace_back(m_index++, std::forward<OutputType>(value));
+                }
+                m_stats.pulled(count);
+                m_stats.yielded(count);
+                return count;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Skip the next elements and advance the index accordingly
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override {
+            if (m_parent) {
+                size_t skipped = m_parent->advanceBy(count);
+                m_index += skipped;
+                return skipped;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent iterator
+         */
+        SizeHint sizeHint() const override {
+            if (m_parent) {
+                return m_parent->sizeHint();
+            }
+            return SizeHint::exact(0);
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            double parentSeconds = m_parent ? m_parent->collectStats(report) : 0.0;
+            return m_stats.report(report, "enumerate", parentSeconds);
+        }
+
         /**
          * @brief Enumerate an iterator
          * @return Enumerate iterator
@@ -111,6 +171,10 @@ namespace itertools {
         size_t m_index;
         // Iterator
         std::shared_ptr<IIterator<OutputType>> m_parent;
+        // Buffer of the last batch pulled from the parent
+        Batch<OutputType> m_batch;
+        // Statistics of the iterator
+        StageCounter m_stats;
     };
 
 } // namespace itertools
@@ -0,0 +1,274 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_FILE_HXX_
+#define _ITERTOOLS_FILE_HXX_
+
+#include "io.hxx"
+#include "iterator.hxx"
+#include "optional.hxx"
+#include "types.hxx"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace itertools {
+    /**
+     * @brief Iterator over the delimited records of a file
+     * @details The records are yielded as views into the file without copying them. A view is valid as long as the
+     * iterator exists. If the file can't be mapped into memory (e.g. a pipe), a view is only valid until the next
+     * element is pulled from the iterator.
+     */
+    class SplitIterator : public IIterator<std::string_view> {
+      public:
+        /**
+         * @brief Open a file to split into records
+         * @param path Path of the file
+         * @param delimiter Delimiter terminating each record
+         */
+        SplitIterator(std::string const &path, char delimiter) : m_file(path), m_delimiter(delimiter) {}
+
+        /**
+         * @brief Get the next record of the file
+         * @return Next record without delimiter or None if the end is reached
+         */
+        Option<std::string_view> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            Option<std::string_view> opt = pull();
+            if (opt.isSome()) {
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+            }
+            return opt;
+        }
+
+        /**
+         * @brief Append the next records to the given buffer
+         * @details Only records available without reading more bytes are added after the first one. Thus, all views of
+         * the batch stay valid until the next element is pulled.
+         * @param buffer Buffer to append the records to
+         * @param maxCount Maximum number of records to append
+         * @return Number of appended records, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<std::string_view> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (maxCount == 0) {
+                return 0;
+            }
+            Option<std::string_view> opt = pull();
+            if (opt.isNone()) {
+                return 0;
+            }
+            buffer.push_back(opt.get());
+            size_t count = 1;
+            std::string_view data = m_file.data();
+            size_t offset = 0;
+            for (; count < maxCount; ++count) {
+                size_t pos = data.find(m_delimiter, offset);
+                if (pos == std::string_view::npos) {
+                    break;
+                }
+                buffer.push_back(data.substr(offset, pos - offset));
+                offset = pos + 1;
+            }
+            m_file.consume(offset);
+            m_stats.pulled(count);
+            m_stats.yielded(count);
+            return count;
+        }
+
+        /**
+         * @brief Append the statistics of this iterator to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator
+         */
+        double collectStats(StatsReport &report) const override { return m_stats.report(report, "split", 0.0); }
+
+      private:
+        /**
+         * @brief Read the next record of the file
+         * @return Next record without delimiter or None if the end is reached
+         */
+        Option<std::string_view> pull() {
+            size_t searched = 0;
+            while (true) {
+                std::string_view data = m_file.data();
+                size_t pos = data.find(m_delimiter, searched);
+                if (pos != std::string_view::npos) {
+                    m_file.consume(pos + 1);
+                    return Option<std::string_view>(data.substr(0, pos));
+                }
+                searched = data.size();
+                if (!m_file.fill()) {
+                    data = m_file.data();
+                    m_file.consume(data.size());
+                    if (data.empty()) {
+                        return Option<std::string_view>();
+                    }
+                    return Option<std::string_view>(data);
+                }
+            }
+        }
+
+        // File to split
+        FileBuffer m_file;
+        // Delimiter terminating each record
+        char m_delimiter;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+    /**
+     * @brief Iterator over the fixed-size binary records of a file
+     * @details The records are yielded as references into the file without copying them. A reference is valid as long
+     * as the iterator exists. If the file can't be mapped into memory (e.g. a pipe), a reference is only valid until
+     * the next element is pulled from the iterator. Bytes at the end of the file not forming a complete record are
+     * ignored.
+     * @typeparam RecordType Type of the records
+     */
+    template <typename RecordType>
+    class RecordIterator : public IIterator<RecordType const &> {
+        static_assert(std::is_trivially_copyable_v<RecordType>, "records must be trivially copyable");
+        static_assert(alignof(RecordType) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "records must not be over-aligned");
+
+      public:
+        /**
+         * @brief Open a file of records
+         * @param path Path of the file
+         */
+        RecordIterator(std::string const &path) : m_file(path) {}
+
+        /**
+         * @brief Get the next record of the file
+         * @return Next record or None if the end is reached
+         */
+        Option<RecordType const &> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            Option<RecordType const &> opt = pull();
+            if (opt.isSome()) {
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+            }
+            return opt;
+        }
+
+        /**
+         * @brief Append the next records to the given buffer
+         * @details Only records available without reading more bytes are added after the first one. Thus, all
+         * references of the batch stay valid until the next element is pulled.
+         * @param buffer Buffer to append the records to
+         * @param maxCount Maximum number of records to append
+         * @return Number of appended records, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<RecordType const &> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (maxCount == 0 || pull().isNone()) {
+                return 0;
+            }
+            std::string_view data = m_file.data();
+            RecordType const *records = reinterpret_cast<RecordType const *>(data.data()) - 1;
+            size_t count = std::min(maxCount, data.size() / sizeof(RecordType) + 1);
+            for (size_t i = 0; i < count; ++i) {
+                buffer.push_back(records[i]);
+            }
+            m_file.consume((count - 1) * sizeof(RecordType));
+            m_stats.pulled(count);
+            m_stats.yielded(count);
+            return count;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining records
+         * @return Exact number of remaining records if the file is mapped
+         */
+        SizeHint sizeHint() const override {
+            if (m_file.isMapped()) {
+                return SizeHint::exact(m_file.data().size() / sizeof(RecordType));
+            }
+            return SizeHint();
+        }
+
+        /**
+         * @brief Append the statistics of this iterator to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator
+         */
+        double collectStats(StatsReport &report) const override { return m_stats.report(report, "records", 0.0); }
+
+      private:
+        /**
+         * @brief Read the next record of the file
+         * @return Next record or None if the end is reached
+         */
+        Option<RecordType const &> pull() {
+            while (m_file.data().size() < sizeof(RecordType)) {
+                if (!m_file.fill()) {
+                    return Option<RecordType const &>();
+                }
+            }
+            RecordType const *record = reinterpret_cast<RecordType const *>(m_file.data().data());
+            m_file.consume(sizeof(RecordType));
+            return Option<RecordType const &>(*record);
+        }
+
+        // File of records
+        FileBuffer m_file;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+    /**
+     * @brief Create new iterator over the lines of a file
+     * @param path Path of the file
+     * @return New iterator yielding each line without line break
+     */
+    inline IteratorWrapper<SplitIterator, std::string_view> Iterator::lines(std::string const &path) {
+        return split(path, '\n');
+    }
+
+    /**
+     * @brief Create new iterator over the delimited records of a file
+     * @param path Path of the file
+     * @param delimiter Delimiter terminating each record
+     * @return New iterator yielding each record without delimiter
+     */
+    inline IteratorWrapper<SplitIterator, std::string_view> Iterator::split(std::string const &path, char delimiter) {
+        return IteratorWrapper<SplitIterator, std::string_view>(std::make_shared<SplitIterator>(path, delimiter));
+    }
+
+    /**
+     * @brief Create new iterator over the fixed-size binary records of a file
+     * @typeparam RecordType Type of the records
+     * @param path Path of the file
+     * @return New iterator yielding a reference to each record
+     */
+    template <typename RecordType>
+    IteratorWrapper<RecordIterator<RecordType>, RecordType const &> Iterator::records(std::string const &path) {
+        return IteratorWrapper<RecordIterator<RecordType>, RecordType const &>(
+            std::make_shared<RecordIterator<RecordType>>(path));
+    }
+
+} // namespace itertools
+
+#endif
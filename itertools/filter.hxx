@@ -23,11 +23,14 @@
 #ifndef _ITERTOOLS_FILTER_HXX_
 #define _ITERTOOLS_FILTER_HXX_
 
+#include "kernels.hxx"
 #include "optional.hxx"
 #include "types.hxx"
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace itertools {
     /**
@@ -51,12 +54,15 @@ namespace itertools {
          * reached
          */
         Option<ValueType> next() override {
+            StageCounter::Scope scope = m_stats.next();
             while (m_parent) {
                 Option<ValueType> opt = m_parent->next();
                 if (opt.isNone()) {
                     return opt;
                 } else {
+                    m_stats.pulled(1);
                     if (m_filter(opt.get())) {
+                        m_stats.yielded(1);
                         return opt;
                     }
                 }
@@ -64,6 +70,62 @@ namespace itertools {
             return Option<ValueType>();
         }
 
+        /**
+         * @brief Append the next elements passing the filter to the given buffer
+         * @details Blocks are pulled from the parent until at least one element passes or the end is reached.
+         * Arithmetic values are compacted without data dependent branches.
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<ValueType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            size_t count = 0;
+            while (m_parent && count == 0) {
+                m_batch.clear();
+                if (m_parent->nextBatch(m_batch, maxCount) == 0) {
+                    break;
+                }
+                m_stats.pulled(m_batch.size());
+                if constexpr (kernels::isSupported<ValueType>()) {
+                    size_t size = buffer.size();
+                    buffer.resize(size + m_batch.size());
+                    count = kernels::compact(m_batch.data(), m_batch.size(), buffer.data() + size, m_filter);
+                    buffer.resize(size + count);
+                } else {
+                    for (ValueType &value : m_batch) {
+                        if (m_filter(value)) {
+                            buffer.push_back(std::forward<ValueType>(value));
+                            ++count;
+                        }
+                    }
+                }
+            }
+            m_stats.yielded(count);
+            return count;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Upper bound of the parent iterator
+         */
+        SizeHint sizeHint() const override {
+            if (m_parent) {
+                return m_parent->sizeHint().atMost();
+            }
+            return SizeHint::exact(0);
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            double parentSeconds = m_parent ? m_parent->collectStats(report) : 0.0;
+            return m_stats.report(report, "filter", parentSeconds);
+        }
+
         /**
          * @brief Zip iterator with another iterator
          * @typeparam OutputType Output type of the other iterator
@@ -109,6 +171,10 @@ namespace itertools {
         std::shared_ptr<IIterator<ValueType>> m_parent;
         // Filter function
         std::function<bool(ValueType &)> m_filter;
+        // Buffer of the last batch pulled from the parent
+        Batch<ValueType> m_batch;
+        // Statistics of the iterator
+        StageCounter m_stats;
     };
 } // namespace itertools
 
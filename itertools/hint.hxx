@@ -0,0 +1,147 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_HINT_HXX_
+#define _ITERTOOLS_HINT_HXX_
+
+#include "optional.hxx"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace itertools {
+    /**
+     * @brief Bounds of the number of remaining elements of an iterator
+     */
+    class SizeHint {
+      public:
+        /**
+         * @brief Create a hint without any knowledge about the number of elements
+         */
+        SizeHint() : m_lower(0), m_upper() {}
+
+        /**
+         * @brief Create a hint from lower and upper bound
+         * @param lower Minimal number of remaining elements
+         * @param upper Maximal number of remaining elements, None if unbounded
+         */
+        SizeHint(size_t lower, Option<size_t> upper) : m_lower(lower), m_upper(upper) {}
+
+        /**
+         * @brief Create a hint of an exactly known number of elements
+         * @param count Number of remaining elements
+         * @return Exact hint
+         */
+        static SizeHint exact(size_t count) { return SizeHint(count, Option<size_t>(count)); }
+
+        /**
+         * @brief Get the minimal number of remaining elements
+         * @return Lower bound
+         */
+        size_t lower() const { return m_lower; }
+
+        /**
+         * @brief Get the maximal number of remaining elements
+         * @return Upper bound, None if unbounded
+         */
+        Option<size_t> upper() const { return m_upper; }
+
+        /**
+         * @brief Check whether the number of remaining elements is known exactly
+         * @return True if lower and upper bound are equal, false otherwise
+         */
+        bool isExact() const { return m_upper.isSome() && m_upper.get() == m_lower; }
+
+        /**
+         * @brief Get the hint of an iterator yielding at most as many elements as this one
+         * @return Hint with lower bound 0 and the same upper bound
+         */
+        SizeHint atMost() const { return SizeHint(0, m_upper); }
+
+        /**
+         * @brief Get the hint of an iterator yielding as many elements as the shorter of two iterators
+         * @param other Hint of the other iterator
+         * @return Hint with the minimum of both bounds
+         */
+        SizeHint min(SizeHint const &other) const {
+            if (m_upper.isNone()) {
+                return SizeHint(std::min(m_lower, other.m_lower), other.m_upper);
+            } else if (other.m_upper.isNone()) {
+                return SizeHint(std::min(m_lower, other.m_lower), m_upper);
+            }
+            return SizeHint(std::min(m_lower, other.m_lower),
+                            Option<size_t>(std::min(m_upper.get(), other.m_upper.get())));
+        }
+
+        /**
+         * @brief Get the hint of an iterator whose number of elements is a function of the number of this one
+         * @param function Monotonically increasing function applied to both bounds
+         * @return Hint with the transformed bounds
+         */
+        template <typename Function>
+        SizeHint transform(Function function) const {
+            if (m_upper.isNone()) {
+                return SizeHint(function(m_lower), m_upper);
+            }
+            return SizeHint(function(m_lower), Option<size_t>(function(m_upper.get())));
+        }
+
+      private:
+        // Minimal number of remaining elements
+        size_t m_lower;
+        // Maximal number of remaining elements, None if unbounded
+        Option<size_t> m_upper;
+    };
+
+    /**
+     * @brief Check whether a collection supports reserve()
+     * @typeparam Collection Type of the collection
+     */
+    template <typename Collection, typename = void>
+    struct IsReservable : std::false_type {};
+
+    /**
+     * @brief Check whether a collection supports reserve()
+     * @typeparam Collection Type of the collection
+     */
+    template <typename Collection>
+    struct IsReservable<Collection, std::void_t<decltype(std::declval<Collection &>().reserve(size_t()))>>
+        : std::true_type {};
+
+    /**
+     * @brief Reserve space for the guaranteed number of elements if supported by the collection
+     * @param collection Collection to reserve space in
+     * @param hint Hint of the number of elements to add
+     */
+    template <typename Collection>
+    void reserve(Collection &collection, SizeHint const &hint) {
+        if constexpr (IsReservable<Collection>::value) {
+            if (hint.lower() > 0) {
+                collection.reserve(collection.size() + hint.lower());
+            }
+        }
+    }
+
+} // namespace itertools
+
+#endif
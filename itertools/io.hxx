@@ -0,0 +1,230 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_IO_HXX_
+#define _ITERTOOLS_IO_HXX_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace itertools {
+    /**
+     * @brief Read-only view of a file's content
+     * @details Regular files are mapped into memory as a whole. Other files (e.g. pipes) are read in chunks into an
+     * internal buffer. In this case, fill() moves the unread bytes and thus invalidates previously returned views.
+     */
+    class FileBuffer {
+      public:
+        /**
+         * @brief Number of bytes read at once if the file can't be mapped
+         */
+        static constexpr size_t ChunkSize = 1 << 16;
+
+        /**
+         * @brief Open a file for reading
+         * @param path Path of the file
+         * @throws std::system_error if the file can't be opened
+         */
+        FileBuffer(std::string const &path)
+            : m_fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC)), m_map(nullptr), m_size(0), m_begin(0), m_end(0),
+              m_eof(false) {
+            if (m_fd < 0) {
+                throw std::system_error(errno, std::generic_category(), path);
+            }
+            struct stat st;
+            if (::fstat(m_fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+                void *map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_fd, 0);
+                if (map != MAP_FAILED) {
+                    ::madvise(map, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                    m_map = static_cast<char const *>(map);
+                    m_size = static_cast<size_t>(st.st_size);
+                    m_end = m_size;
+                    m_eof = true;
+                }
+            }
+        }
+
+        /**
+         * @brief Unmap and close the file
+         */
+        ~FileBuffer() {
+            if (m_map) {
+                ::munmap(const_cast<char *>(m_map), m_size);
+            }
+            ::close(m_fd);
+        }
+
+        FileBuffer(FileBuffer const &) = delete;
+        FileBuffer &operator=(FileBuffer const &) = delete;
+
+        /**
+         * @brief Check whether the file is mapped into memory
+         * @return True if the whole file is mapped, false if it is read in chunks
+         */
+        bool isMapped() const { return m_map != nullptr; }
+
+        /**
+         * @brief Get the available bytes that are not consumed yet
+         * @return View of the unread bytes
+         */
+        std::string_view data() const { return std::string_view(base() + m_begin, m_end - m_begin); }
+
+        /**
+         * @brief Mark bytes as consumed
+         * @param count Number of bytes to consume
+         */
+        void consume(size_t count) { m_begin += count; }
+
+        /**
+         * @brief Read more bytes of the file
+         * @details The unread bytes are moved to the start of the buffer, which invalidates previous views.
+         * @return True if bytes were added, false if the end of the file is reached
+         * @throws std::system_error if reading fails
+         */
+        bool fill() {
+            if (m_eof) {
+                return false;
+            }
+            size_t unread = m_end - m_begin;
+            if (m_begin > 0) {
+                std::memmove(m_buffer.data(), m_buffer.data() + m_begin, unread);
+                m_begin = 0;
+                m_end = unread;
+            }
+            if (m_buffer.size() - m_end < ChunkSize) {
+                m_buffer.resize(std::max(m_buffer.size() * 2, m_end + ChunkSize));
+            }
+            while (true) {
+                ssize_t count = ::read(m_fd, m_buffer.data() + m_end, m_buffer.size() - m_end);
+                if (count > 0) {
+                    m_end += static_cast<size_t>(count);
+                    return true;
+                } else if (count == 0) {
+                    m_eof = true;
+                    return false;
+                } else if (errno != EINTR) {
+                    throw std::system_error(errno, std::generic_category(), "read");
+                }
+            }
+        }
+
+      private:
+        /**
+         * @brief Get the start of the file content
+         * @return Start of the mapping or the buffer
+         */
+        char const *base() const { return m_map ? m_map : m_buffer.data(); }
+
+        // File descriptor
+        int m_fd;
+        // Start of the mapping, nullptr if not mapped
+        char const *m_map;
+        // Size of the mapping
+        size_t m_size;
+        // Buffer of the read bytes if not mapped
+        std::vector<char> m_buffer;
+        // Offset of the first unread byte
+        size_t m_begin;
+        // Offset after the last available byte
+        size_t m_end;
+        // True if all bytes of the file are available
+        bool m_eof;
+    };
+
+    /**
+     * @brief Buffered writer of elements to a file descriptor
+     */
+    class FileSink {
+      public:
+        /**
+         * @brief Number of bytes buffered before writing them
+         */
+        static constexpr size_t BufferSize = 1 << 16;
+
+        /**
+         * @brief Create a new sink writing to a file descriptor
+         * @param fd File descriptor to write to, not closed by the sink
+         */
+        FileSink(int fd) : m_fd(fd) { m_buffer.reserve(BufferSize); }
+
+        /**
+         * @brief Append an element followed by the delimiter
+         * @details Elements convertible to std::string_view are written as they are, all others based on operator<<.
+         * @param value Element to write
+         * @param delimiter Delimiter written after the element
+         */
+        template <typename ValueType>
+        void write(ValueType const &value, char delimiter) {
+            if constexpr (std::is_convertible_v<ValueType const &, std::string_view>) {
+                m_buffer.append(std::string_view(value));
+            } else {
+                m_stream.str(std::string());
+                m_stream << value;
+                m_buffer.append(m_stream.str());
+            }
+            m_buffer.push_back(delimiter);
+            if (m_buffer.size() >= BufferSize) {
+                flush();
+            }
+        }
+
+        /**
+         * @brief Write all buffered bytes to the file descriptor
+         * @throws std::system_error if writing fails
+         */
+        void flush() {
+            size_t offset = 0;
+            while (offset < m_buffer.size()) {
+                ssize_t count = ::write(m_fd, m_buffer.data() + offset, m_buffer.size() - offset);
+                if (count >= 0) {
+                    offset += static_cast<size_t>(count);
+                } else if (errno != EINTR) {
+                    throw std::system_error(errno, std::generic_category(), "write");
+                }
+            }
+            m_buffer.clear();
+        }
+
+      private:
+        // File descriptor to write to
+        int m_fd;
+        // Buffered bytes
+        std::string m_buffer;
+        // Stream used to format elements
+        std::ostringstream m_stream;
+    };
+
+} // namespace itertools
+
+#endif
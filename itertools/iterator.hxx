@@ -23,11 +23,22 @@
 #ifndef _ITERTOOLS_ITERATOR_HXX_
 #define _ITERTOOLS_ITERATOR_HXX_
 
+#include "io.hxx"
+#include "kernels.hxx"
+#include "memory.hxx"
 #include "optional.hxx"
+#include "table.hxx"
 #include "types.hxx"
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace itertools {
 
@@ -38,14 +49,88 @@ namespace itertools {
       public:
         /**
          * @brief Create new iterator from a container
+         * @details If a memory resource is given, all nodes of the chain are placed in it.
          * @typename Container Container type
          * @param container Container to iterate over
+         * @param resource Memory resource to allocate the nodes from, nullptr to use the global heap
          * @return New basic iterator
          */
         template <typename Container>
-        static IteratorWrapper<BasicIterator<Container>, typename Container::value_type> from(Container &container) {
+        static IteratorWrapper<BasicIterator<Container>, typename Container::value_type>
+        from(Container &container, std::pmr::memory_resource *resource = nullptr) {
             return IteratorWrapper<BasicIterator<Container>, typename Container::value_type>(
-                std::make_shared<BasicIterator<Container>>(container));
+                makeShared<BasicIterator<Container>>(resource, container), resource);
+        }
+
+        /**
+         * @brief Create new iterator consuming a container
+         * @details The iterator takes ownership of the container and moves the elements out of it.
+         * @typename Container Container type
+         * @param container Container to consume
+         * @param resource Memory resource to allocate the nodes from, nullptr to use the global heap
+         * @return New basic iterator
+         */
+        template <typename Container, typename = std::enable_if_t<!std::is_lvalue_reference_v<Container>>>
+        static IteratorWrapper<BasicIterator<Container>, typename Container::value_type>
+        from(Container &&container, std::pmr::memory_resource *resource = nullptr) {
+            return IteratorWrapper<BasicIterator<Container>, typename Container::value_type>(
+                makeShared<BasicIterator<Container>>(resource, std::move(container)), resource);
+        }
+
+        /**
+         * @brief Create new iterator borrowing the elements of a container
+         * @details The iterator yields references to the elements instead of copies.
+         * @typename Container Container type
+         * @param container Container to iterate over
+         * @param resource Memory resource to allocate the nodes from, nullptr to use the global heap
+         * @return New basic iterator
+         */
+        template <typename Container>
+        static IteratorWrapper<BasicIterator<Container, typename Container::value_type &>,
+                               typename Container::value_type &>
+        borrow(Container &container, std::pmr::memory_resource *resource = nullptr) {
+            return IteratorWrapper<BasicIterator<Container, typename Container::value_type &>,
+                                   typename Container::value_type &>(
+                makeShared<BasicIterator<Container, typename Container::value_type &>>(resource, container), resource);
+        }
+
+        /**
+         * @brief Create new iterator over the lines of a file
+         * @details Regular files are mapped into memory, all others are read in chunks.
+         * @param path Path of the file
+         * @return New iterator yielding each line without line break
+         */
+        static IteratorWrapper<SplitIterator, std::string_view> lines(std::string const &path);
+
+        /**
+         * @brief Create new iterator over the delimited records of a file
+         * @details Regular files are mapped into memory, all others are read in chunks.
+         * @param path Path of the file
+         * @param delimiter Delimiter terminating each record
+         * @return New iterator yielding each record without delimiter
+         */
+        static IteratorWrapper<SplitIterator, std::string_view> split(std::string const &path, char delimiter);
+
+        /**
+         * @brief Create new iterator over the fixed-size binary records of a file
+         * @details Regular files are mapped into memory, all others are read in chunks.
+         * @typeparam RecordType Type of the records
+         * @param path Path of the file
+         * @return New iterator yielding a reference to each record
+         */
+        template <typename RecordType>
+        static IteratorWrapper<RecordIterator<RecordType>, RecordType const &> records(std::string const &path);
+
+        /**
+         * @brief Create new statically composed pipeline from a container
+         * @details All stages of the pipeline are stored by value and can be inlined into a single loop.
+         * @typename Container Container type
+         * @param container Container to iterate over
+         * @return New static pipeline
+         */
+        template <typename Container>
+        static StaticWrapper<StaticBasic<Container>> fuse(Container &container) {
+            return StaticWrapper<StaticBasic<Container>>(StaticBasic<Container>(container));
         }
     };
 
@@ -58,12 +143,29 @@ namespace itertools {
     template <typename IteratorType, typename OutputType>
     class IteratorWrapper {
       public:
+        /**
+         * @brief Number of elements pulled at once by the terminal operations
+         */
+        static constexpr size_t BatchSize = 1024;
+
+        /**
+         * @brief Type of the values owned by the reductions, i.e. the output type without reference
+         */
+        using ValueType = std::remove_cv_t<std::remove_reference_t<OutputType>>;
+
+        /**
+         * @brief Type of the values accumulated by the reductions across batches, views are copied into strings
+         */
+        using ReducedType = typename OwnedElement<ValueType>::Type;
+
         /**
          * @brief Create new iterator wrapper from shared_ptr
          * @param iterator Iterator to wrap
+         * @param resource Memory resource to allocate chained nodes from, nullptr to use the global heap
          * @return New iterator wrapper
          */
-        IteratorWrapper(std::shared_ptr<IteratorType> iterator) : m_iterator(iterator) {}
+        IteratorWrapper(std::shared_ptr<IteratorType> iterator, std::pmr::memory_resource *resource = nullptr)
+            : m_iterator(iterator), m_resource(resource) {}
 
         /**
          * @brief Create zipped iterator from this and another iterator
@@ -75,7 +177,8 @@ namespace itertools {
         IteratorWrapper<ZipIterator<OutputType, OtherOutputType>, std::pair<OutputType, OtherOutputType>>
         zip(IteratorWrapper<IIterator<OtherOutputType>, OtherOutputType> other) {
             return IteratorWrapper<ZipIterator<OutputType, OtherOutputType>, std::pair<OutputType, OtherOutputType>>(
-                m_iterator->zip(other.inner()));
+                makeShared<ZipIterator<OutputType, OtherOutputType>>(m_resource, m_iterator, other.inner()),
+                m_resource);
         }
 
         /**
@@ -83,7 +186,8 @@ namespace itertools {
          * @return Enumerated iterator
          */
         IteratorWrapper<EnumerateIterator<OutputType>, std::pair<size_t, OutputType>> enumerate() {
-            return IteratorWrapper<EnumerateIterator<OutputType>, std::pair<size_t, OutputType>>(m_iterator->enumerate());
+            return IteratorWrapper<EnumerateIterator<OutputType>, std::pair<size_t, OutputType>>(
+                makeShared<EnumerateIterator<OutputType>>(m_resource, m_iterator), m_resource);
         }
 
         /**
@@ -92,7 +196,8 @@ namespace itertools {
          * @return Filtered iterator
          */
         IteratorWrapper<FilterIterator<OutputType>, OutputType> filter(std::function<bool(OutputType &)> filter) {
-            return IteratorWrapper<FilterIterator<OutputType>, OutputType>(m_iterator->filter(filter));
+            return IteratorWrapper<FilterIterator<OutputType>, OutputType>(
+                makeShared<FilterIterator<OutputType>>(m_resource, filter, m_iterator), m_resource);
         }
 
         /**
@@ -104,7 +209,97 @@ namespace itertools {
         template <typename OtherOutputType>
         IteratorWrapper<MapIterator<OutputType, OtherOutputType>, OtherOutputType>
         map(std::function<OtherOutputType(OutputType &)> map) {
-            return IteratorWrapper<MapIterator<OutputType, OtherOutputType>, OtherOutputType>(m_iterator->map(map));
+            return IteratorWrapper<MapIterator<OutputType, OtherOutputType>, OtherOutputType>(
+                makeShared<MapIterator<OutputType, OtherOutputType>>(m_resource, map, m_iterator), m_resource);
+        }
+
+        /**
+         * @brief Create iterator skipping the first elements of this
+         * @details Skipped elements of random access containers are not touched and maps are not applied to them.
+         * @param count Number of elements to skip
+         * @return Skipping iterator
+         */
+        IteratorWrapper<SkipIterator<OutputType>, OutputType> skip(size_t count) {
+            return IteratorWrapper<SkipIterator<OutputType>, OutputType>(
+                makeShared<SkipIterator<OutputType>>(m_resource, m_iterator, count), m_resource);
+        }
+
+        /**
+         * @brief Create iterator yielding only the first elements of this
+         * @param count Maximum number of elements to yield
+         * @return Limited iterator
+         */
+        IteratorWrapper<TakeIterator<OutputType>, OutputType> take(size_t count) {
+            return IteratorWrapper<TakeIterator<OutputType>, OutputType>(
+                makeShared<TakeIterator<OutputType>>(m_resource, m_iterator, count), m_resource);
+        }
+
+        /**
+         * @brief Create iterator yielding every n-th element of this, starting with the first
+         * @details The elements in between are skipped like in skip().
+         * @param step Distance between the yielded elements
+         * @return Stepping iterator
+         */
+        IteratorWrapper<StepByIterator<OutputType>, OutputType> stepBy(size_t step) {
+            return IteratorWrapper<StepByIterator<OutputType>, OutputType>(
+                makeShared<StepByIterator<OutputType>>(m_resource, m_iterator, step), m_resource);
+        }
+
+        /**
+         * @brief Create iterator yielding the elements of this in chunks
+         * @details The elements must stay valid after the next pull, thus views of file records can't be chunked.
+         * @param size Number of elements per chunk, the last chunk may be smaller
+         * @return Chunking iterator
+         */
+        IteratorWrapper<ChunksIterator<OutputType>, Batch<OutputType>> chunks(size_t size) {
+            return IteratorWrapper<ChunksIterator<OutputType>, Batch<OutputType>>(
+                makeShared<ChunksIterator<OutputType>>(m_resource, m_iterator, size), m_resource);
+        }
+
+        /**
+         * @brief Get the n-th element, skipping the elements before like in skip()
+         * @param index Index of the element, relative to the current position
+         * @return Element at the index or None if the end is reached before
+         */
+        Option<OutputType> nth(size_t index) {
+            if (m_iterator->advanceBy(index) < index) {
+                return Option<OutputType>();
+            }
+            return m_iterator->next();
+        }
+
+        /**
+         * @brief Run the chain up to this iterator on its own thread
+         * @details The elements are handed over in batches through a bounded ring buffer. Thus, the upstream chain
+         * runs concurrently with the stages after it, e.g. an I/O bound source with a CPU bound mapping.
+         * @param capacity Number of batches buffered between the threads
+         * @return Asynchronous iterator
+         */
+        IteratorWrapper<AsyncIterator<OutputType>, OutputType>
+        async(size_t capacity = AsyncIterator<OutputType>::DefaultCapacity) {
+            return IteratorWrapper<AsyncIterator<OutputType>, OutputType>(
+                makeShared<AsyncIterator<OutputType>>(m_resource, m_iterator, capacity), m_resource);
+        }
+
+        /**
+         * @brief Create mapped iterator applying the map on several worker threads
+         * @details The chain up to this iterator runs on its own thread and hands batches round-robin to the workers.
+         * The map is called concurrently and must be thread-safe.
+         * @typeparam OtherOutputType Output type of the mapped values
+         * @param map Mapping to apply to each element
+         * @param workers Number of worker threads
+         * @param ordered Whether to keep the order of the elements
+         * @param capacity Number of batches buffered per worker
+         * @return Asynchronous mapped iterator
+         */
+        template <typename OtherOutputType>
+        IteratorWrapper<AsyncIterator<OtherOutputType>, OtherOutputType>
+        asyncMap(std::function<OtherOutputType(OutputType &)> map, size_t workers, bool ordered = true,
+                 size_t capacity = AsyncIterator<OtherOutputType>::DefaultCapacity) {
+            std::shared_ptr<IIterator<OutputType>> parent = m_iterator;
+            return IteratorWrapper<AsyncIterator<OtherOutputType>, OtherOutputType>(
+                makeShared<AsyncIterator<OtherOutputType>>(m_resource, parent, map, workers, ordered, capacity),
+                m_resource);
         }
 
         /**
@@ -112,7 +307,7 @@ namespace itertools {
          * @return Wrapper of iterator interface
          */
         IteratorWrapper<IIterator<OutputType>, OutputType> into() {
-            return IteratorWrapper<IIterator<OutputType>, OutputType>(m_iterator);
+            return IteratorWrapper<IIterator<OutputType>, OutputType>(m_iterator, m_resource);
         }
 
         /**
@@ -130,30 +325,58 @@ namespace itertools {
 
         /**
          * @brief Returns the product of all elements
+         * @details Contiguous arithmetic sources are reduced by the vectorized kernels.
          * @return Product of all elements based on operator*, None if no elements
          */
-        Option<OutputType> product() {
-            Option<OutputType> prod = m_iterator->next();
-            Option<OutputType> opt = m_iterator->next();
-            while (opt.isSome()) {
-                prod.get() *= opt.get();
-                opt = m_iterator->next();
+        Option<ReducedType> product() {
+            if constexpr (kernels::IsContiguousSource<IteratorType>::value) {
+                return reduceContiguous(kernels::product<ValueType>);
             }
-            return prod;
+            return reduceBatches([](ReducedType &acc, OutputType &value) { acc *= value; });
         }
 
         /**
          * @brief Returns the sum of all elements
+         * @details Contiguous arithmetic sources are reduced by the vectorized kernels.
          * @return Sum of all elements based on operator+, None if no elements
          */
-        Option<OutputType> sum() {
-            Option<OutputType> s = m_iterator->next();
-            Option<OutputType> opt = m_iterator->next();
-            while (opt.isSome()) {
-                s.get() += opt.get();
-                opt = m_iterator->next();
+        Option<ReducedType> sum() {
+            if constexpr (kernels::IsContiguousSource<IteratorType>::value) {
+                return reduceContiguous(kernels::sum<ValueType>);
+            }
+            return reduceBatches([](ReducedType &acc, OutputType &value) { acc += value; });
+        }
+
+        /**
+         * @brief Returns the minimum of all elements
+         * @details Contiguous arithmetic sources are reduced by the vectorized kernels.
+         * @return First minimal element based on operator<, views are returned as std::string, None if no elements
+         */
+        Option<ReducedType> min() {
+            if constexpr (kernels::IsContiguousSource<IteratorType>::value) {
+                return reduceContiguous(kernels::min<ValueType>);
             }
-            return s;
+            return reduceBatches([](ReducedType &acc, OutputType &value) {
+                if (value < acc) {
+                    acc = value;
+                }
+            });
+        }
+
+        /**
+         * @brief Returns the maximum of all elements
+         * @details Contiguous arithmetic sources are reduced by the vectorized kernels.
+         * @return First maximal element based on operator<, views are returned as std::string, None if no elements
+         */
+        Option<ReducedType> max() {
+            if constexpr (kernels::IsContiguousSource<IteratorType>::value) {
+                return reduceContiguous(kernels::max<ValueType>);
+            }
+            return reduceBatches([](ReducedType &acc, OutputType &value) {
+                if (acc < value) {
+                    acc = value;
+                }
+            });
         }
 
         /**
@@ -163,11 +386,14 @@ namespace itertools {
          */
         template <typename Collection>
         Collection collectInsert() {
-            Collection c;
-            Option<OutputType> opt = m_iterator->next();
-            while (opt.isSome()) {
-                c.insert(opt.get());
-                opt = m_iterator->next();
+            Collection c = makeCollection<Collection>(m_resource);
+            reserve(c, m_iterator->sizeHint());
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                for (OutputType &value : batch) {
+                    c.insert(std::forward<OutputType>(value));
+                }
+                batch.clear();
             }
             return c;
         }
@@ -179,15 +405,129 @@ namespace itertools {
          */
         template <typename Collection>
         Collection collectPush() {
-            Collection c;
-            Option<OutputType> opt = m_iterator->next();
-            while (opt.isSome()) {
-                c.push_back(opt.get());
-                opt = m_iterator->next();
+            Collection c = makeCollection<Collection>(m_resource);
+            reserve(c, m_iterator->sizeHint());
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                for (OutputType &value : batch) {
+                    c.push_back(std::forward<OutputType>(value));
+                }
+                batch.clear();
             }
             return c;
         }
 
+        /**
+         * @brief Group all values by a key
+         * @details The table is sized up front from the expected number of keys, or the size hint if not given.
+         * @typeparam Key Type of the keys
+         * @param key Function computing the key of a value
+         * @param expected Expected number of keys, 0 if unknown
+         * @return Table of the values of each key in the order of the iterator
+         */
+        template <typename Key>
+        FlatHashMap<Key, std::vector<ValueType>> groupBy(std::function<Key(OutputType &)> key, size_t expected = 0) {
+            FlatHashMap<Key, std::vector<ValueType>> table(expectedKeys(m_iterator->sizeHint(), expected));
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                for (OutputType &value : batch) {
+                    table.tryEmplace(key(value)).first->push_back(std::forward<OutputType>(value));
+                }
+                batch.clear();
+            }
+            return table;
+        }
+
+        /**
+         * @brief Reduce all values with the same key
+         * @details The first value of a key is the initial accumulator, all further values are combined into it with
+         * combine(accumulator, value).
+         * @typeparam Key Type of the keys
+         * @param key Function computing the key of a value
+         * @param combine Function combining a value into the accumulator of its key
+         * @param expected Expected number of keys, 0 if unknown
+         * @return Table of the accumulator of each key
+         */
+        template <typename Key>
+        FlatHashMap<Key, ValueType> reduceByKey(std::function<Key(OutputType &)> key,
+                                                std::function<void(ValueType &, OutputType &)> combine,
+                                                size_t expected = 0) {
+            FlatHashMap<Key, ValueType> table(expectedKeys(m_iterator->sizeHint(), expected));
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                for (OutputType &value : batch) {
+                    std::pair<ValueType *, bool> result = table.tryEmplace(key(value), std::forward<OutputType>(value));
+                    if (!result.second) {
+                        combine(*result.first, value);
+                    }
+                }
+                batch.clear();
+            }
+            return table;
+        }
+
+        /**
+         * @brief Count the values of each key
+         * @typeparam Key Type of the keys
+         * @param key Function computing the key of a value
+         * @param expected Expected number of keys, 0 if unknown
+         * @return Table of the number of values of each key
+         */
+        template <typename Key>
+        FlatHashMap<Key, size_t> countBy(std::function<Key(OutputType &)> key, size_t expected = 0) {
+            FlatHashMap<Key, size_t> table(expectedKeys(m_iterator->sizeHint(), expected));
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                for (OutputType &value : batch) {
+                    ++*table.tryEmplace(key(value)).first;
+                }
+                batch.clear();
+            }
+            return table;
+        }
+
+        /**
+         * @brief Write all elements to a file descriptor
+         * @details Elements convertible to std::string_view are written as they are, all others based on operator<<.
+         * @param fd File descriptor to write to, not closed afterwards
+         * @param delimiter Delimiter written after each element
+         * @return Number of written elements
+         * @throws std::system_error if writing fails
+         */
+        size_t writeTo(int fd, char delimiter = '\n') {
+            size_t count = 0;
+            FileSink sink(fd);
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                for (OutputType &value : batch) {
+                    sink.write(value, delimiter);
+                }
+                count += batch.size();
+                batch.clear();
+            }
+            sink.flush();
+            return count;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @details Use an exact hint to preallocate output buffers.
+         * @return Bounds of the number of remaining elements
+         */
+        SizeHint sizeHint() const { return m_iterator->sizeHint(); }
+
+        /**
+         * @brief Get the statistics of all stages of the iterator chain
+         * @details Statistics are only recorded if ITERTOOLS_STATS is defined, otherwise the report is empty. Times
+         * are extrapolated from sampled calls.
+         * @return Report of the stages ordered from the sources to the last stage
+         */
+        StatsReport stats() const {
+            StatsReport report;
+            m_iterator->collectStats(report);
+            return report;
+        }
+
         /**
          * @brief Return reference to inner shared_ptr
          * @return Reference to inner shared_ptr
@@ -195,8 +535,47 @@ namespace itertools {
         std::shared_ptr<IteratorType> inner() { return m_iterator; }
 
       private:
+        /**
+         * @brief Reduce all elements pulled in batches
+         * @details The accumulator owns its value, as the elements may only be valid until the next pull.
+         * @param op Operation combining the accumulated value with the next element
+         * @return Reduced value, None if no elements
+         */
+        template <typename Operation>
+        Option<ReducedType> reduceBatches(Operation op) {
+            Option<ReducedType> acc;
+            Batch<OutputType> batch;
+            while (m_iterator->nextBatch(batch, BatchSize) != 0) {
+                size_t i = 0;
+                if (acc.isNone()) {
+                    acc = Option<ReducedType>(ReducedType(std::forward<OutputType>(batch[i++])));
+                }
+                for (; i < batch.size(); ++i) {
+                    op(acc.get(), batch[i]);
+                }
+                batch.clear();
+            }
+            return acc;
+        }
+
+        /**
+         * @brief Reduce the remaining elements of a contiguous source with a kernel
+         * @param kernel Kernel reducing a contiguous range
+         * @return Reduced value, None if no elements
+         */
+        template <typename Kernel>
+        Option<ValueType> reduceContiguous(Kernel kernel) {
+            auto slice = m_iterator->nextSlice(std::numeric_limits<size_t>::max());
+            if (slice.first == slice.second) {
+                return Option<ValueType>();
+            }
+            return Option<ValueType>(kernel(&*slice.first, static_cast<size_t>(slice.second - slice.first)));
+        }
+
         // Shared reference to the iterator
         std::shared_ptr<IteratorType> m_iterator;
+        // Memory resource to allocate chained nodes and collections from, nullptr to use the global heap
+        std::pmr::memory_resource *m_resource;
     };
 
 } // namespace itertools
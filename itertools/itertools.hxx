@@ -25,11 +25,31 @@
  */
 #include "optional.hxx"
 
+/**
+ * @brief This header contains the size hint of iterators
+ */
+#include "hint.hxx"
+
+/**
+ * @brief This header contains the per-stage statistics of iterator chains
+ */
+#include "stats.hxx"
+
+/**
+ * @brief This header contains the flat hash map used by the aggregations
+ */
+#include "table.hxx"
+
 /**
  * @brief This header contains the forward declarations of the iterator types
  */
 #include "types.hxx"
 
+/**
+ * @brief This header contains the allocation helpers for memory resources
+ */
+#include "memory.hxx"
+
 /**
  * @brief This header contains the iterator wrapper and interface
  */
@@ -59,3 +79,38 @@
  * @brief This header contains the enumerate iterator template definition
  */
 #include "enumerate.hxx"
+
+/**
+ * @brief This header contains the skip, take, step and chunk iterator template definitions
+ */
+#include "slice.hxx"
+
+/**
+ * @brief This header contains the statically composed pipeline definitions
+ */
+#include "static.hxx"
+
+/**
+ * @brief This header contains the work-stealing thread pool
+ */
+#include "pool.hxx"
+
+/**
+ * @brief This header contains the parallel execution of static pipelines
+ */
+#include "parallel.hxx"
+
+/**
+ * @brief This header contains the iterators running their upstream chain on separate threads
+ */
+#include "async.hxx"
+
+/**
+ * @brief This header contains the buffered file reader and writer
+ */
+#include "io.hxx"
+
+/**
+ * @brief This header contains the iterators over the records of a file
+ */
+#include "file.hxx"
@@ -0,0 +1,219 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_KERNELS_HXX_
+#define _ITERTOOLS_KERNELS_HXX_
+
+#include "types.hxx"
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace itertools {
+    /**
+     * @brief Vectorizable kernels over contiguous ranges of arithmetic values
+     * @details The kernels split the range into independent lanes, so that the compiler is able to map them to the
+     * SIMD registers of the targeted instruction set (SSE, AVX2 or AVX-512 depending on -march). Integer results are
+     * bit-for-bit identical to a sequential fold since the lanes accumulate with wrap-around arithmetic. Floating point
+     * values are folded strictly in order unless ITERTOOLS_FLOAT_REASSOCIATE is defined. In that case, the lanes are
+     * reassociated and results may differ from the sequential fold in the last bits.
+     */
+    namespace kernels {
+        /**
+         * @brief Number of independent lanes used by the kernels
+         */
+        constexpr size_t Lanes = 16;
+
+        /**
+         * @brief Check whether the kernels support the given type
+         * @typeparam ValueType Type of the values
+         */
+        template <typename ValueType>
+        constexpr bool isSupported() {
+            return std::is_arithmetic_v<ValueType> && !std::is_same_v<ValueType, bool>;
+        }
+
+        /**
+         * @brief Check whether the kernels may reorder operations on the given type
+         * @typeparam ValueType Type of the values
+         */
+        template <typename ValueType>
+        constexpr bool isReorderable() {
+#ifdef ITERTOOLS_FLOAT_REASSOCIATE
+            return true;
+#else
+            return std::is_integral_v<ValueType>;
+#endif
+        }
+
+        /**
+         * @brief Accumulator type of the lanes
+         * @details Integers are accumulated unsigned to get well-defined wrap-around arithmetic.
+         * @typeparam ValueType Type of the values
+         */
+        template <typename ValueType>
+        using LaneType =
+            typename std::conditional_t<std::is_integral_v<ValueType>, std::make_unsigned<ValueType>,
+                                        std::common_type<ValueType>>::type;
+
+        /**
+         * @brief Type the lane arithmetic is performed in
+         * @details Unsigned lanes narrower than int would be promoted to signed int, whose overflow is undefined.
+         * Thus, they are widened to unsigned int instead.
+         * @typeparam LaneValueType Type of the lanes
+         */
+        template <typename LaneValueType>
+        using ArithmeticType = typename std::conditional_t<std::is_integral_v<LaneValueType>,
+                                                           std::common_type<unsigned, LaneValueType>,
+                                                           std::common_type<LaneValueType>>::type;
+
+        /**
+         * @brief Fold all values of a range with the given operation
+         * @typeparam AccType Type of the accumulators
+         * @param data Pointer to the first value
+         * @param count Number of values, at least 1
+         * @param op Associative and commutative operation
+         * @return Folded value
+         */
+        template <typename AccType, typename ValueType, typename Operation>
+        ValueType fold(ValueType const *data, size_t count, Operation op) {
+            size_t i = 1;
+            AccType result = static_cast<AccType>(data[0]);
+            if constexpr (isReorderable<ValueType>()) {
+                if (count >= Lanes) {
+                    AccType acc[Lanes];
+                    for (size_t j = 0; j < Lanes; ++j) {
+                        acc[j] = static_cast<AccType>(data[j]);
+                    }
+                    for (i = Lanes; i + Lanes <= count; i += Lanes) {
+                        for (size_t j = 0; j < Lanes; ++j) {
+                            acc[j] = op(acc[j], static_cast<AccType>(data[i + j]));
+                        }
+                    }
+                    result = acc[0];
+                    for (size_t j = 1; j < Lanes; ++j) {
+                        result = op(result, acc[j]);
+                    }
+                }
+            }
+            for (; i < count; ++i) {
+                result = op(result, static_cast<AccType>(data[i]));
+            }
+            return static_cast<ValueType>(result);
+        }
+
+        /**
+         * @brief Sum of all values of a range
+         * @param data Pointer to the first value
+         * @param count Number of values, at least 1
+         * @return Sum of all values
+         */
+        template <typename ValueType>
+        ValueType sum(ValueType const *data, size_t count) {
+            return fold<LaneType<ValueType>>(data, count, [](auto a, auto b) {
+                using Arithmetic = ArithmeticType<decltype(a)>;
+                return static_cast<decltype(a)>(static_cast<Arithmetic>(a) + static_cast<Arithmetic>(b));
+            });
+        }
+
+        /**
+         * @brief Product of all values of a range
+         * @param data Pointer to the first value
+         * @param count Number of values, at least 1
+         * @return Product of all values
+         */
+        template <typename ValueType>
+        ValueType product(ValueType const *data, size_t count) {
+            return fold<LaneType<ValueType>>(data, count, [](auto a, auto b) {
+                using Arithmetic = ArithmeticType<decltype(a)>;
+                return static_cast<decltype(a)>(static_cast<Arithmetic>(a) * static_cast<Arithmetic>(b));
+            });
+        }
+
+        /**
+         * @brief Minimum of all values of a range
+         * @param data Pointer to the first value
+         * @param count Number of values, at least 1
+         * @return Minimum of all values
+         */
+        template <typename ValueType>
+        ValueType min(ValueType const *data, size_t count) {
+            return fold<ValueType>(data, count, [](auto a, auto b) { return b < a ? b : a; });
+        }
+
+        /**
+         * @brief Maximum of all values of a range
+         * @param data Pointer to the first value
+         * @param count Number of values, at least 1
+         * @return Maximum of all values
+         */
+        template <typename ValueType>
+        ValueType max(ValueType const *data, size_t count) {
+            return fold<ValueType>(data, count, [](auto a, auto b) { return a < b ? b : a; });
+        }
+
+        /**
+         * @brief Copy all values passing the predicate into the output range
+         * @details Every value is stored unconditionally and the output position is advanced by the result of the
+         * predicate. Thus, the loop is free of data dependent branches. The predicate is applied first, so changes
+         * it makes to the value are stored as well.
+         * @param input Pointer to the first input value
+         * @param count Number of input values
+         * @param output Pointer to the output range with space for count values
+         * @param predicate Predicate to apply
+         * @return Number of values passing the predicate
+         */
+        template <typename ValueType, typename Predicate>
+        size_t compact(ValueType *input, size_t count, ValueType *output, Predicate &predicate) {
+            size_t k = 0;
+            for (size_t i = 0; i < count; ++i) {
+                bool keep = predicate(input[i]);
+                output[k] = input[i];
+                k += keep ? 1 : 0;
+            }
+            return k;
+        }
+
+        /**
+         * @brief Check whether an iterator type is a basic iterator over contiguous arithmetic values
+         * @typeparam IteratorType Type of the iterator
+         */
+        template <typename IteratorType, typename = void>
+        struct IsContiguousSource : std::false_type {};
+
+        /**
+         * @brief Check whether an iterator type is a basic iterator over contiguous arithmetic values
+         * @typeparam Container Type of the iterated container
+         */
+        template <typename Container>
+        struct IsContiguousSource<BasicIterator<Container, typename Container::value_type>,
+                                  std::void_t<decltype(std::declval<Container &>().data())>>
+            : std::bool_constant<isSupported<typename Container::value_type>() &&
+                                 std::is_base_of_v<std::random_access_iterator_tag,
+                                                   typename std::iterator_traits<
+                                                       typename Container::iterator>::iterator_category>> {};
+    } // namespace kernels
+
+} // namespace itertools
+
+#endif
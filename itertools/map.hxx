@@ -28,6 +28,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 namespace itertools {
     /**
@@ -52,17 +53,69 @@ namespace itertools {
          * @return Next element in the mapped container or None if the end is reached
          */
         Option<OutputType> next() override {
+            StageCounter::Scope scope = m_stats.next();
             if (m_parent) {
                 Option<InputType> opt = m_parent->next();
                 if (opt.isNone()) {
                     return Option<OutputType>();
                 } else {
+                    m_stats.pulled(1);
+                    m_stats.yielded(1);
                     return Option<OutputType>(m_map(opt.get()));
                 }
             }
             return Option<OutputType>();
         }
 
+        /**
+         * @brief Append the next mapped elements to the given buffer
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<OutputType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (m_parent) {
+                m_batch.clear();
+                size_t count = m_parent->nextBatch(m_batch, maxCount);
+                for (InputType &value : m_batch) {
+                    buffer.push_back(m_map(value));
+                }
+                m_stats.pulled(count);
+                m_stats.yielded(count);
+                return count;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Skip the next elements without mapping them
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override { return m_parent ? m_parent->advanceBy(count) : 0; }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent iterator
+         */
+        SizeHint sizeHint() const override {
+            if (m_parent) {
+                return m_parent->sizeHint();
+            }
+            return SizeHint::exact(0);
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            double parentSeconds = m_parent ? m_parent->collectStats(report) : 0.0;
+            return m_stats.report(report, "map", parentSeconds);
+        }
+
         /**
          * @brief Zip iterator with another iterator
          * @typeparam OtherOutputType Output type of the other iterator
@@ -108,6 +161,10 @@ namespace itertools {
         std::shared_ptr<IIterator<InputType>> m_parent;
         // Mapping function
         std::function<OutputType(InputType &)> m_map;
+        // Buffer of the last batch pulled from the parent
+        Batch<InputType> m_batch;
+        // Statistics of the iterator
+        StageCounter m_stats;
     };
 
 } // namespace itertools
@@ -0,0 +1,68 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_MEMORY_HXX_
+#define _ITERTOOLS_MEMORY_HXX_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace itertools {
+    /**
+     * @brief Create a shared node, placed in the given memory resource if any
+     * @details Node and control block are created by a single allocation in both cases.
+     * @typeparam Node Type of the node
+     * @param resource Memory resource to allocate from, nullptr to use the global heap
+     * @param args Arguments passed to the constructor of the node
+     * @return Shared pointer to the new node
+     */
+    template <typename Node, typename... Args>
+    std::shared_ptr<Node> makeShared(std::pmr::memory_resource *resource, Args &&...args) {
+        if (resource) {
+            return std::allocate_shared<Node>(std::pmr::polymorphic_allocator<Node>(resource),
+                                              std::forward<Args>(args)...);
+        }
+        return std::make_shared<Node>(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Create an empty collection, using the given memory resource if the collection supports it
+     * @typeparam Collection Type of the collection
+     * @param resource Memory resource to allocate from, nullptr to use the default allocator
+     * @return Empty collection
+     */
+    template <typename Collection>
+    Collection makeCollection(std::pmr::memory_resource *resource) {
+        if constexpr (std::uses_allocator_v<Collection, std::pmr::polymorphic_allocator<std::byte>>) {
+            if (resource) {
+                return Collection(typename Collection::allocator_type(resource));
+            }
+        }
+        return Collection();
+    }
+
+} // namespace itertools
+
+#endif
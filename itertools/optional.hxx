@@ -24,10 +24,15 @@
 #define _ITERTOOLS_OPTIONAL_HXX_
 
 #include <assert.h>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace itertools {
     /**
      * @brief Optional type
+     * @details The value is stored in place and only constructed if present. Thus, the type of the value doesn't have
+     * to be default constructible.
      * @typeparam T Type of the optional value
      */
     template <typename ValueType>
@@ -41,25 +46,90 @@ namespace itertools {
         /**
          * @brief Construct a new mepty Option object
          */
-        Option() : m_hasValue(false), m_value() {}
+        Option() : m_hasValue(false) {}
 
         /**
          * @brief Construct a new Option object from given value
-         * @param value The value to be stored in the Option
+         * @param value The value to be copied into the Option
          */
-        Option(ValueType value) : m_hasValue(true), m_value(value) {}
+        Option(ValueType const &value) : m_hasValue(true) { new (&m_value) ValueType(value); }
+
+        /**
+         * @brief Construct a new Option object from given value
+         * @param value The value to be moved into the Option
+         */
+        Option(ValueType &&value) : m_hasValue(true) { new (&m_value) ValueType(std::move(value)); }
+
+        /**
+         * @brief Construct a new Option object as copy of another Option
+         * @param other The Option to copy
+         */
+        Option(Option const &other) : m_hasValue(other.m_hasValue) {
+            if (m_hasValue) {
+                new (&m_value) ValueType(other.m_value);
+            }
+        }
+
+        /**
+         * @brief Construct a new Option object by moving the value of another Option
+         * @param other The Option to move from
+         */
+        Option(Option &&other) noexcept(std::is_nothrow_move_constructible_v<ValueType>)
+            : m_hasValue(other.m_hasValue) {
+            if (m_hasValue) {
+                new (&m_value) ValueType(std::move(other.m_value));
+            }
+        }
+
+        /**
+         * @brief Destroy the Option object and its value
+         */
+        ~Option() { reset(); }
+
+        /**
+         * @brief Replace the value by a copy of the value of another Option
+         * @param other The Option to copy
+         * @return Reference to this Option
+         */
+        Option &operator=(Option const &other) {
+            if (this != &other) {
+                reset();
+                if (other.m_hasValue) {
+                    new (&m_value) ValueType(other.m_value);
+                    m_hasValue = true;
+                }
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Replace the value by the moved value of another Option
+         * @param other The Option to move from
+         * @return Reference to this Option
+         */
+        Option &operator=(Option &&other) noexcept(std::is_nothrow_move_constructible_v<ValueType> &&
+                                                   std::is_nothrow_move_assignable_v<ValueType>) {
+            if (this != &other) {
+                reset();
+                if (other.m_hasValue) {
+                    new (&m_value) ValueType(std::move(other.m_value));
+                    m_hasValue = true;
+                }
+            }
+            return *this;
+        }
 
         /**
          * @brief Check if the Option has a value
          * @return True if the Option has a value, false otherwise
          */
-        bool isSome() { return m_hasValue; }
+        bool isSome() const { return m_hasValue; }
 
         /**
          * @brief Check if the Option has no value
          * @return True if the Option has no value, false otherwise
          */
-        bool isNone() { return !isSome(); }
+        bool isNone() const { return !isSome(); }
 
         /**
          * @brief Get the value of the Option
@@ -70,11 +140,104 @@ namespace itertools {
             return m_value;
         }
 
+        /**
+         * @brief Get the value of the Option
+         * @return The value of the optional type
+         */
+        ValueType const &get() const {
+            assert(m_hasValue);
+            return m_value;
+        }
+
+        /**
+         * @brief Move the value out of the Option and leave it empty
+         * @return The value of the optional type
+         */
+        ValueType take() {
+            assert(m_hasValue);
+            ValueType value(std::move(m_value));
+            reset();
+            return value;
+        }
+
       private:
+        /**
+         * @brief Destroy the value if present
+         */
+        void reset() {
+            if (m_hasValue) {
+                m_value.~ValueType();
+                m_hasValue = false;
+            }
+        }
+
         // True if the Option has a value, false otherwise
         bool m_hasValue;
-        // The value of the Option
-        ValueType m_value;
+        // The value of the Option, only constructed if m_hasValue is true
+        union {
+            ValueType m_value;
+        };
+    };
+
+    /**
+     * @brief Optional reference
+     * @details Used by borrowing iterators to yield the elements of a container without copying them.
+     * @typeparam T Type of the referenced value
+     */
+    template <typename ValueType>
+    class Option<ValueType &> {
+      public:
+        /**
+         * @brief Static None value
+         */
+        static Option<ValueType &> const None;
+
+        /**
+         * @brief Construct a new mepty Option object
+         */
+        Option() : m_value(nullptr) {}
+
+        /**
+         * @brief Construct a new Option object referencing the given value
+         * @param value The value to be referenced by the Option
+         */
+        Option(ValueType &value) : m_value(&value) {}
+
+        /**
+         * @brief Check if the Option has a value
+         * @return True if the Option has a value, false otherwise
+         */
+        bool isSome() const { return m_value != nullptr; }
+
+        /**
+         * @brief Check if the Option has no value
+         * @return True if the Option has no value, false otherwise
+         */
+        bool isNone() const { return !isSome(); }
+
+        /**
+         * @brief Get the referenced value of the Option
+         * @return The referenced value
+         */
+        ValueType &get() const {
+            assert(m_value != nullptr);
+            return *m_value;
+        }
+
+        /**
+         * @brief Get the referenced value and leave the Option empty
+         * @return The referenced value
+         */
+        ValueType &take() {
+            assert(m_value != nullptr);
+            ValueType *value = m_value;
+            m_value = nullptr;
+            return *value;
+        }
+
+      private:
+        // Pointer to the referenced value, nullptr if empty
+        ValueType *m_value;
     };
 
 } // namespace itertools
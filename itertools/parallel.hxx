@@ -0,0 +1,299 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_PARALLEL_HXX_
+#define _ITERTOOLS_PARALLEL_HXX_
+
+#include "hint.hxx"
+#include "optional.hxx"
+#include "pool.hxx"
+#include "static.hxx"
+#include "table.hxx"
+#include "types.hxx"
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itertools {
+    /**
+     * @brief Wrapper class for statically composed pipelines executed in parallel
+     * @details The source range is split into chunks and each chunk is processed by its own copy of the pipeline on
+     * the thread pool. The results of the chunks are merged in the order of the source. If the pipeline can't be split
+     * (e.g. source without random access or enumerate after filter), it is executed sequentially.
+     * @typeparam Stage Type of the last stage of the pipeline
+     */
+    template <typename Stage>
+    class ParallelWrapper {
+      public:
+        /**
+         * @brief Type of the elements yielded by the pipeline
+         */
+        using OutputType = typename Stage::OutputType;
+
+        /**
+         * @brief Type of the keys computed by a key function of the aggregations
+         * @typeparam KeyFunction Type of the key function
+         */
+        template <typename KeyFunction>
+        using KeyType = typename StaticWrapper<Stage>::template KeyType<KeyFunction>;
+
+        /**
+         * @brief Minimal number of source elements per chunk
+         */
+        static constexpr size_t MinChunkSize = 4096;
+
+        /**
+         * @brief Number of chunks created per worker thread to balance the load
+         */
+        static constexpr size_t ChunksPerThread = 4;
+
+        /**
+         * @brief Create new parallel wrapper from a stage
+         * @param stage Stage to wrap
+         * @param pool Thread pool to execute the pipeline on
+         */
+        ParallelWrapper(Stage stage, ThreadPool &pool) : m_stage(std::move(stage)), m_pool(pool) {}
+
+        /**
+         * @brief Returns the product of all elements
+         * @details The partial products of the chunks are combined by tree reduction.
+         * @return Product of all elements based on operator*, None if no elements
+         */
+        Option<OutputType> product() {
+            return reduce([](StaticWrapper<Stage> chunk) { return chunk.product(); },
+                          [](OutputType &acc, OutputType &value) { acc *= value; });
+        }
+
+        /**
+         * @brief Returns the sum of all elements
+         * @details The partial sums of the chunks are combined by tree reduction.
+         * @return Sum of all elements based on operator+, None if no elements
+         */
+        Option<OutputType> sum() {
+            return reduce([](StaticWrapper<Stage> chunk) { return chunk.sum(); },
+                          [](OutputType &acc, OutputType &value) { acc += value; });
+        }
+
+        /**
+         * @brief Collects all values of the pipeline into a container in the order of the source
+         * @typeparam Collection Type of the container
+         * @return Container with all values of the pipeline
+         */
+        template <typename Collection>
+        Collection collectInsert() {
+            std::vector<std::vector<OutputType>> chunks = collectChunks();
+            Collection c;
+            reserve(c, SizeHint::exact(totalSize(chunks)));
+            for (std::vector<OutputType> &chunk : chunks) {
+                for (OutputType &value : chunk) {
+                    c.insert(std::move(value));
+                }
+            }
+            return c;
+        }
+
+        /**
+         * @brief Collects all values of the pipeline into a container in the order of the source
+         * @typeparam Collection Type of the container
+         * @return Container with all values of the pipeline
+         */
+        template <typename Collection>
+        Collection collectPush() {
+            std::vector<std::vector<OutputType>> chunks = collectChunks();
+            Collection c;
+            reserve(c, SizeHint::exact(totalSize(chunks)));
+            for (std::vector<OutputType> &chunk : chunks) {
+                for (OutputType &value : chunk) {
+                    c.push_back(std::move(value));
+                }
+            }
+            return c;
+        }
+
+        /**
+         * @brief Group all values by a key
+         * @details Every chunk builds its own table, the tables are merged by tree reduction.
+         * @typeparam KeyFunction Type of the key function
+         * @param key Function computing the key of a value, called concurrently
+         * @param expected Expected number of keys per chunk, 0 to size the tables from the size hints
+         * @return Table of the values of each key in the order of the source
+         */
+        template <typename KeyFunction>
+        FlatHashMap<KeyType<KeyFunction>, std::vector<OutputType>> groupBy(KeyFunction key, size_t expected = 0) {
+            return aggregate([&key, expected](StaticWrapper<Stage> chunk) { return chunk.groupBy(key, expected); },
+                             [](std::vector<OutputType> &values, std::vector<OutputType> &other) {
+                                 values.insert(values.end(), std::make_move_iterator(other.begin()),
+                                               std::make_move_iterator(other.end()));
+                             });
+        }
+
+        /**
+         * @brief Reduce all values with the same key
+         * @details Every chunk builds its own table, the tables are merged by tree reduction. Thus, combine must also
+         * accept two accumulators and be associative.
+         * @typeparam KeyFunction Type of the key function
+         * @typeparam Combine Type of the combine function
+         * @param key Function computing the key of a value, called concurrently
+         * @param combine Function combining a value into the accumulator of its key, called concurrently
+         * @param expected Expected number of keys per chunk, 0 to size the tables from the size hints
+         * @return Table of the accumulator of each key
+         */
+        template <typename KeyFunction, typename Combine>
+        FlatHashMap<KeyType<KeyFunction>, OutputType> reduceByKey(KeyFunction key, Combine combine,
+                                                                  size_t expected = 0) {
+            return aggregate(
+                [&key, &combine, expected](StaticWrapper<Stage> chunk) {
+                    return chunk.reduceByKey(key, combine, expected);
+                },
+                combine);
+        }
+
+        /**
+         * @brief Count the values of each key
+         * @details Every chunk builds its own table, the tables are merged by tree reduction.
+         * @typeparam KeyFunction Type of the key function
+         * @param key Function computing the key of a value, called concurrently
+         * @param expected Expected number of keys per chunk, 0 to size the tables from the size hints
+         * @return Table of the number of values of each key
+         */
+        template <typename KeyFunction>
+        FlatHashMap<KeyType<KeyFunction>, size_t> countBy(KeyFunction key, size_t expected = 0) {
+            return aggregate([&key, expected](StaticWrapper<Stage> chunk) { return chunk.countBy(key, expected); },
+                             [](size_t &count, size_t &other) { count += other; });
+        }
+
+      private:
+        /**
+         * @brief Get the number of chunks the source is split into
+         * @return Number of chunks, 1 if the pipeline can't be split
+         */
+        size_t chunkCount() {
+            if constexpr (Stage::Splittable) {
+                size_t chunks = std::min(m_stage.size() / MinChunkSize, m_pool.size() * ChunksPerThread);
+                return std::max<size_t>(chunks, 1);
+            }
+            return 1;
+        }
+
+        /**
+         * @brief Get the pipeline processing a single chunk
+         * @param index Index of the chunk
+         * @param count Number of chunks
+         * @return Pipeline of the chunk
+         */
+        StaticWrapper<Stage> chunk(size_t index, size_t count) {
+            if constexpr (Stage::Splittable) {
+                size_t size = m_stage.size();
+                return StaticWrapper<Stage>(m_stage.slice(size * index / count, size * (index + 1) / count));
+            }
+            return StaticWrapper<Stage>(m_stage);
+        }
+
+        /**
+         * @brief Reduce all chunks and combine the partial results by tree reduction
+         * @param run Function reducing a single chunk
+         * @param op Operation combining two partial results
+         * @return Reduced value, None if no elements
+         */
+        template <typename Run, typename Operation>
+        Option<OutputType> reduce(Run run, Operation op) {
+            size_t count = chunkCount();
+            std::vector<Option<OutputType>> partial(count);
+            m_pool.parallelFor(count, [this, &partial, &run, count](size_t i) { partial[i] = run(chunk(i, count)); });
+            for (size_t step = 1; step < count; step *= 2) {
+                m_pool.parallelFor((count + 2 * step - 1) / (2 * step), [&partial, &op, step, count](size_t i) {
+                    size_t left = i * 2 * step;
+                    size_t right = left + step;
+                    if (right < count && partial[right].isSome()) {
+                        if (partial[left].isSome()) {
+                            op(partial[left].get(), partial[right].get());
+                        } else {
+                            partial[left] = partial[right];
+                        }
+                    }
+                });
+            }
+            return partial[0];
+        }
+
+        /**
+         * @brief Aggregate all chunks into tables and merge them by tree reduction
+         * @details The left table of each pair absorbs the right one, so the keys keep the order of the source.
+         * @param run Function aggregating a single chunk into a table
+         * @param combine Function combining the values of a key found in both tables
+         * @return Merged table
+         */
+        template <typename Run, typename Combine>
+        std::invoke_result_t<Run, StaticWrapper<Stage>> aggregate(Run run, Combine combine) {
+            using Table = std::invoke_result_t<Run, StaticWrapper<Stage>>;
+            size_t count = chunkCount();
+            std::vector<Table> tables(count);
+            m_pool.parallelFor(count, [this, &tables, &run, count](size_t i) { tables[i] = run(chunk(i, count)); });
+            for (size_t step = 1; step < count; step *= 2) {
+                m_pool.parallelFor((count + 2 * step - 1) / (2 * step), [&tables, &combine, step, count](size_t i) {
+                    size_t left = i * 2 * step;
+                    size_t right = left + step;
+                    if (right < count) {
+                        tables[left].merge(std::move(tables[right]), combine);
+                    }
+                });
+            }
+            return std::move(tables[0]);
+        }
+
+        /**
+         * @brief Collect the values of all chunks
+         * @return Values of each chunk in the order of the source
+         */
+        std::vector<std::vector<OutputType>> collectChunks() {
+            size_t count = chunkCount();
+            std::vector<std::vector<OutputType>> chunks(count);
+            m_pool.parallelFor(count, [this, &chunks, count](size_t i) {
+                chunks[i] = chunk(i, count).template collectPush<std::vector<OutputType>>();
+            });
+            return chunks;
+        }
+
+        /**
+         * @brief Get the number of values of all chunks
+         * @param chunks Values of each chunk
+         * @return Total number of values
+         */
+        static size_t totalSize(std::vector<std::vector<OutputType>> const &chunks) {
+            size_t size = 0;
+            for (std::vector<OutputType> const &chunk : chunks) {
+                size += chunk.size();
+            }
+            return size;
+        }
+
+        // Last stage of the pipeline
+        Stage m_stage;
+        // Thread pool to execute the pipeline on
+        ThreadPool &m_pool;
+    };
+
+} // namespace itertools
+
+#endif
@@ -0,0 +1,231 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_POOL_HXX_
+#define _ITERTOOLS_POOL_HXX_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace itertools {
+    /**
+     * @brief Work-stealing thread pool
+     * @details Every worker owns a task queue. Workers take tasks from the back of their own queue and steal from the
+     * front of the queues of other workers if their own queue is empty.
+     */
+    class ThreadPool {
+      public:
+        /**
+         * @brief Create a new thread pool
+         * @param threads Number of worker threads, the number of hardware threads if 0
+         */
+        ThreadPool(size_t threads = 0) : m_pending(0), m_next(0), m_stop(false) {
+            if (threads == 0) {
+                threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                m_threads.emplace_back([this, i]() { run(i); });
+            }
+        }
+
+        /**
+         * @brief Stop and join all worker threads
+         */
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_condition.notify_all();
+            for (std::thread &thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        ThreadPool(ThreadPool const &) = delete;
+        ThreadPool &operator=(ThreadPool const &) = delete;
+
+        /**
+         * @brief Get the number of worker threads
+         * @return Number of worker threads
+         */
+        size_t size() const { return m_threads.size(); }
+
+        /**
+         * @brief Call the function for every index in [0, count) and wait until all calls are done
+         * @details The calling thread executes queued tasks while waiting. Thus, it is safe to call this function from
+         * within a task. The first exception thrown by any call is rethrown after all calls are done.
+         * @param count Number of indices
+         * @param function Function to call with each index
+         */
+        template <typename Function>
+        void parallelFor(size_t count, Function function) {
+            struct State {
+                std::atomic<size_t> remaining;
+                std::mutex mutex;
+                std::condition_variable condition;
+                std::exception_ptr exception;
+            };
+            auto state = std::make_shared<State>();
+            state->remaining = count;
+            for (size_t i = 0; i < count; ++i) {
+                push([state, &function, i]() {
+                    try {
+                        function(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if (!state->exception) {
+                            state->exception = std::current_exception();
+                        }
+                    }
+                    if (--state->remaining == 0) {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        state->condition.notify_all();
+                    }
+                });
+            }
+            std::function<void()> task;
+            while (state->remaining != 0) {
+                if (pop(m_next++ % m_queues.size(), task)) {
+                    task();
+                } else {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    state->condition.wait(lock, [&state]() { return state->remaining == 0; });
+                }
+            }
+            if (state->exception) {
+                std::rethrow_exception(state->exception);
+            }
+        }
+
+        /**
+         * @brief Get the global thread pool using all hardware threads
+         * @return Global thread pool
+         */
+        static ThreadPool &global() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+      private:
+        /**
+         * @brief Task queue of a single worker
+         */
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        /**
+         * @brief Push a task to the queue of the next worker
+         * @details The task is counted before it is queued, so a worker stealing it right away can't decrement the
+         * number of queued tasks below zero.
+         * @param task Task to push
+         */
+        void push(std::function<void()> task) {
+            Queue &queue = *m_queues[m_next++ % m_queues.size()];
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_pending;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.tasks.push_back(std::move(task));
+            }
+            m_condition.notify_one();
+        }
+
+        /**
+         * @brief Pop a task from the own queue or steal one from another queue
+         * @param index Index of the own queue
+         * @param task Task to fill
+         * @return True if a task was found, false otherwise
+         */
+        bool pop(size_t index, std::function<void()> &task) {
+            for (size_t i = 0; i < m_queues.size(); ++i) {
+                Queue &queue = *m_queues[(index + i) % m_queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (!queue.tasks.empty()) {
+                    if (i == 0) {
+                        task = std::move(queue.tasks.back());
+                        queue.tasks.pop_back();
+                    } else {
+                        task = std::move(queue.tasks.front());
+                        queue.tasks.pop_front();
+                    }
+                    --m_pending;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Run loop of a worker thread
+         * @param index Index of the worker
+         */
+        void run(size_t index) {
+            std::function<void()> task;
+            while (true) {
+                if (pop(index, task)) {
+                    task();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_stop || m_pending != 0; });
+                if (m_stop && m_pending == 0) {
+                    return;
+                }
+            }
+        }
+
+        // Task queues of the workers
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        // Worker threads
+        std::vector<std::thread> m_threads;
+        // Mutex guarding the sleep of the workers
+        std::mutex m_mutex;
+        // Condition to wake up sleeping workers
+        std::condition_variable m_condition;
+        // Number of queued tasks
+        std::atomic<size_t> m_pending;
+        // Queue index used for the next push
+        std::atomic<size_t> m_next;
+        // True if the workers shall stop
+        bool m_stop;
+    };
+
+} // namespace itertools
+
+#endif
@@ -0,0 +1,367 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_SLICE_HXX_
+#define _ITERTOOLS_SLICE_HXX_
+
+#include "optional.hxx"
+#include "types.hxx"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace itertools {
+    /**
+     * @brief Iterator skipping the first elements of an iterator
+     * @details The elements are skipped lazily with advanceBy() on the first pull. Thus, skipped elements of random
+     * access containers are not touched and upstream maps are not applied to them.
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class SkipIterator : public IIterator<ValueType> {
+      public:
+        /**
+         * @brief Construct a new SkipIterator object
+         * @param parent Parent iterator
+         * @param count Number of elements to skip
+         */
+        SkipIterator(std::shared_ptr<IIterator<ValueType>> parent, size_t count) : m_parent(parent), m_pending(count) {}
+
+        /**
+         * @brief Get the next element after the skipped ones
+         * @return Next element or None if the end is reached
+         */
+        Option<ValueType> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            skip();
+            Option<ValueType> opt = m_parent->next();
+            if (opt.isSome()) {
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+            }
+            return opt;
+        }
+
+        /**
+         * @brief Append the next elements after the skipped ones to the given buffer
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<ValueType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            skip();
+            size_t count = m_parent->nextBatch(buffer, maxCount);
+            m_stats.pulled(count);
+            m_stats.yielded(count);
+            return count;
+        }
+
+        /**
+         * @brief Skip the next elements after the skipped ones
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override {
+            size_t pending = m_pending;
+            m_pending = 0;
+            size_t max = std::numeric_limits<size_t>::max();
+            size_t skipped = m_parent->advanceBy(count > max - pending ? max : pending + count);
+            return skipped > pending ? skipped - pending : 0;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent iterator reduced by the elements to skip
+         */
+        SizeHint sizeHint() const override {
+            size_t pending = m_pending;
+            return m_parent->sizeHint().transform([pending](size_t n) { return n > pending ? n - pending : 0; });
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            return m_stats.report(report, "skip", m_parent->collectStats(report));
+        }
+
+      private:
+        /**
+         * @brief Skip the pending elements of the parent
+         */
+        void skip() {
+            if (m_pending != 0) {
+                m_parent->advanceBy(m_pending);
+                m_pending = 0;
+            }
+        }
+
+        // Parent iterator
+        std::shared_ptr<IIterator<ValueType>> m_parent;
+        // Number of elements still to skip
+        size_t m_pending;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+    /**
+     * @brief Iterator yielding only the first elements of an iterator
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class TakeIterator : public IIterator<ValueType> {
+      public:
+        /**
+         * @brief Construct a new TakeIterator object
+         * @param parent Parent iterator
+         * @param count Maximum number of elements to yield
+         */
+        TakeIterator(std::shared_ptr<IIterator<ValueType>> parent, size_t count)
+            : m_parent(parent), m_remaining(count) {}
+
+        /**
+         * @brief Get the next element if the maximum number isn't reached
+         * @return Next element or None if the end is reached
+         */
+        Option<ValueType> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            if (m_remaining == 0) {
+                return Option<ValueType>();
+            }
+            Option<ValueType> opt = m_parent->next();
+            if (opt.isSome()) {
+                --m_remaining;
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+            } else {
+                m_remaining = 0;
+            }
+            return opt;
+        }
+
+        /**
+         * @brief Append the next elements up to the maximum number to the given buffer
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<ValueType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (m_remaining == 0) {
+                return 0;
+            }
+            size_t count = m_parent->nextBatch(buffer, std::min(maxCount, m_remaining));
+            m_remaining = count == 0 ? 0 : m_remaining - count;
+            m_stats.pulled(count);
+            m_stats.yielded(count);
+            return count;
+        }
+
+        /**
+         * @brief Skip the next elements up to the maximum number
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override {
+            size_t skipped = m_parent->advanceBy(std::min(count, m_remaining));
+            m_remaining = skipped < std::min(count, m_remaining) ? 0 : m_remaining - skipped;
+            return skipped;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent iterator limited by the maximum number
+         */
+        SizeHint sizeHint() const override { return m_parent->sizeHint().min(SizeHint::exact(m_remaining)); }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            return m_stats.report(report, "take", m_parent->collectStats(report));
+        }
+
+      private:
+        // Parent iterator
+        std::shared_ptr<IIterator<ValueType>> m_parent;
+        // Number of elements still to yield
+        size_t m_remaining;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+    /**
+     * @brief Iterator yielding every n-th element of an iterator, starting with the first
+     * @details The elements in between are skipped with advanceBy(), so upstream maps are not applied to them.
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class StepByIterator : public IIterator<ValueType> {
+      public:
+        /**
+         * @brief Construct a new StepByIterator object
+         * @param parent Parent iterator
+         * @param step Distance between the yielded elements, at least 1
+         */
+        StepByIterator(std::shared_ptr<IIterator<ValueType>> parent, size_t step)
+            : m_parent(parent), m_step(std::max<size_t>(step, 1)), m_first(true) {}
+
+        /**
+         * @brief Get the next element after skipping the elements in between
+         * @return Next element or None if the end is reached
+         */
+        Option<ValueType> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            if (!m_first && m_parent->advanceBy(m_step - 1) < m_step - 1) {
+                return Option<ValueType>();
+            }
+            m_first = false;
+            Option<ValueType> opt = m_parent->next();
+            if (opt.isSome()) {
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+            }
+            return opt;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent iterator divided by the step
+         */
+        SizeHint sizeHint() const override {
+            size_t step = m_step;
+            if (m_first) {
+                return m_parent->sizeHint().transform([step](size_t n) { return (n + step - 1) / step; });
+            }
+            return m_parent->sizeHint().transform([step](size_t n) { return n / step; });
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            return m_stats.report(report, "stepBy", m_parent->collectStats(report));
+        }
+
+      private:
+        // Parent iterator
+        std::shared_ptr<IIterator<ValueType>> m_parent;
+        // Distance between the yielded elements
+        size_t m_step;
+        // Whether the first element is yet to be yielded
+        bool m_first;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+    /**
+     * @brief Iterator yielding the elements of an iterator in chunks
+     * @details Every chunk has the requested size except the last one, which holds the remaining elements. References
+     * are stored as std::reference_wrapper. A chunk is filled by several pulls from the parent, so its elements must
+     * stay valid after the next pull. Views of file records are rejected, map them to std::string first. References
+     * returned by Iterator::records() are only valid across pulls if the file is memory mapped.
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class ChunksIterator : public IIterator<Batch<ValueType>> {
+        static_assert(!std::is_same_v<std::remove_cv_t<std::remove_reference_t<ValueType>>, std::string_view>,
+                      "views may dangle across pulls, map them to std::string before chunking");
+
+      public:
+        /**
+         * @brief Construct a new ChunksIterator object
+         * @param parent Parent iterator
+         * @param size Number of elements per chunk, at least 1
+         */
+        ChunksIterator(std::shared_ptr<IIterator<ValueType>> parent, size_t size)
+            : m_parent(parent), m_size(std::max<size_t>(size, 1)) {}
+
+        /**
+         * @brief Get the next chunk
+         * @return Next chunk or None if the end is reached
+         */
+        Option<Batch<ValueType>> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            Batch<ValueType> chunk;
+            reserve(chunk, m_parent->sizeHint().min(SizeHint::exact(m_size)));
+            while (chunk.size() < m_size && m_parent->nextBatch(chunk, m_size - chunk.size()) != 0) {
+            }
+            if (chunk.empty()) {
+                return Option<Batch<ValueType>>();
+            }
+            m_stats.pulled(chunk.size());
+            m_stats.yielded(1);
+            return Option<Batch<ValueType>>(std::move(chunk));
+        }
+
+        /**
+         * @brief Skip the next chunks without pulling their elements
+         * @param count Number of chunks to skip
+         * @return Number of skipped chunks, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override {
+            size_t max = std::numeric_limits<size_t>::max();
+            size_t skipped = m_parent->advanceBy(count > max / m_size ? max : count * m_size);
+            return skipped / m_size + (skipped % m_size != 0 ? 1 : 0);
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining chunks
+         * @return Bounds of the parent iterator divided by the chunk size, rounded up
+         */
+        SizeHint sizeHint() const override {
+            size_t size = m_size;
+            return m_parent->sizeHint().transform([size](size_t n) { return (n + size - 1) / size; });
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            return m_stats.report(report, "chunks", m_parent->collectStats(report));
+        }
+
+      private:
+        // Parent iterator
+        std::shared_ptr<IIterator<ValueType>> m_parent;
+        // Number of elements per chunk
+        size_t m_size;
+        // Statistics of the iterator
+        StageCounter m_stats;
+    };
+
+} // namespace itertools
+
+#endif
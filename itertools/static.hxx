@@ -0,0 +1,700 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_STATIC_HXX_
+#define _ITERTOOLS_STATIC_HXX_
+
+#include "hint.hxx"
+#include "optional.hxx"
+#include "pool.hxx"
+#include "table.hxx"
+#include "types.hxx"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace itertools {
+    /**
+     * @brief Static source stage iterating over a container
+     * @typeparam Container Container type
+     */
+    template <typename Container>
+    class StaticBasic {
+      public:
+        /**
+         * @brief Value type of the elements in the container
+         */
+        using OutputType = typename Container::value_type;
+
+        /**
+         * @brief Container iterator type
+         */
+        using ContainerIter = typename Container::iterator;
+
+        /**
+         * @brief True if the stage can be split into independent ranges of the source
+         */
+        static constexpr bool Splittable =
+            std::is_base_of_v<std::random_access_iterator_tag,
+                              typename std::iterator_traits<ContainerIter>::iterator_category>;
+
+        /**
+         * @brief True if every source element results in exactly one output element
+         */
+        static constexpr bool Preserving = true;
+
+        /**
+         * @brief Create a new source stage from a container
+         * @param container Container to iterate over
+         */
+        StaticBasic(Container &container) : m_begin(container.begin()), m_end(container.end()) {}
+
+        /**
+         * @brief Get the next element in the container
+         * @return Next element in the container or None if the end is reached
+         */
+        Option<OutputType> next() {
+            if (m_begin != m_end) {
+                Option<OutputType> opt = Option<OutputType>(*m_begin);
+                ++m_begin;
+                return opt;
+            } else {
+                return Option<OutputType>();
+            }
+        }
+
+        /**
+         * @brief Get the number of remaining source elements
+         * @return Number of remaining source elements
+         */
+        size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Exact number of remaining elements for random access containers
+         */
+        SizeHint sizeHint() const {
+            if constexpr (Splittable) {
+                return SizeHint::exact(size());
+            }
+            return SizeHint();
+        }
+
+        /**
+         * @brief Create a stage iterating over a range of the remaining source elements
+         * @param begin Index of the first source element
+         * @param end Index after the last source element
+         * @return Stage restricted to the given range
+         */
+        StaticBasic slice(size_t begin, size_t end) const { return StaticBasic(m_begin + begin, m_begin + end); }
+
+      private:
+        /**
+         * @brief Create a new source stage from a range
+         * @param begin Start of the range
+         * @param end End of the range
+         */
+        StaticBasic(ContainerIter begin, ContainerIter end) : m_begin(begin), m_end(end) {}
+
+        // Start of the container
+        ContainerIter m_begin;
+        // End of the container
+        ContainerIter m_end;
+    };
+
+    /**
+     * @brief Static stage mapping each element of its parent stage
+     * @typeparam Parent Type of the parent stage
+     * @typeparam Map Type of the mapping callable
+     * @typeparam RequestedType Explicit output type or void to deduce it from the callable
+     */
+    template <typename Parent, typename Map, typename RequestedType>
+    class StaticMap {
+      public:
+        /**
+         * @brief Type of the input elements
+         */
+        using InputType = typename Parent::OutputType;
+
+        /**
+         * @brief Type of the mapped elements
+         */
+        using OutputType = std::conditional_t<std::is_void_v<RequestedType>,
+                                              std::decay_t<std::invoke_result_t<Map &, InputType &>>, RequestedType>;
+
+        /**
+         * @brief True if the stage can be split into independent ranges of the source
+         */
+        static constexpr bool Splittable = Parent::Splittable;
+
+        /**
+         * @brief True if every source element results in exactly one output element
+         */
+        static constexpr bool Preserving = Parent::Preserving;
+
+        /**
+         * @brief Construct a new StaticMap object
+         * @param parent The parent stage
+         * @param map The mapping callable
+         */
+        StaticMap(Parent parent, Map map) : m_parent(std::move(parent)), m_map(std::move(map)) {}
+
+        /**
+         * @brief Get the next mapped element
+         * @return Next mapped element or None if the end is reached
+         */
+        Option<OutputType> next() {
+            Option<InputType> opt = m_parent.next();
+            if (opt.isNone()) {
+                return Option<OutputType>();
+            } else {
+                return Option<OutputType>(m_map(opt.get()));
+            }
+        }
+
+        /**
+         * @brief Get the number of remaining source elements
+         * @return Number of remaining source elements
+         */
+        size_t size() const { return m_parent.size(); }
+
+        /**
+         * @brief Create a stage iterating over a range of the remaining source elements
+         * @param begin Index of the first source element
+         * @param end Index after the last source element
+         * @return Stage restricted to the given range
+         */
+        StaticMap slice(size_t begin, size_t end) const { return StaticMap(m_parent.slice(begin, end), m_map); }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent stage
+         */
+        SizeHint sizeHint() const { return m_parent.sizeHint(); }
+
+      private:
+        // Parent stage
+        Parent m_parent;
+        // Mapping callable
+        Map m_map;
+    };
+
+    /**
+     * @brief Static stage filtering the elements of its parent stage
+     * @typeparam Parent Type of the parent stage
+     * @typeparam Filter Type of the filter callable
+     */
+    template <typename Parent, typename Filter>
+    class StaticFilter {
+      public:
+        /**
+         * @brief Type of the filtered elements
+         */
+        using OutputType = typename Parent::OutputType;
+
+        /**
+         * @brief True if the stage can be split into independent ranges of the source
+         */
+        static constexpr bool Splittable = Parent::Splittable;
+
+        /**
+         * @brief True if every source element results in exactly one output element
+         */
+        static constexpr bool Preserving = false;
+
+        /**
+         * @brief Construct a new StaticFilter object
+         * @param parent The parent stage
+         * @param filter The filter callable
+         */
+        StaticFilter(Parent parent, Filter filter) : m_parent(std::move(parent)), m_filter(std::move(filter)) {}
+
+        /**
+         * @brief Get the next element passing the filter
+         * @return Next element passing the filter or None if the end is reached
+         */
+        Option<OutputType> next() {
+            while (true) {
+                Option<OutputType> opt = m_parent.next();
+                if (opt.isNone() || m_filter(opt.get())) {
+                    return opt;
+                }
+            }
+        }
+
+        /**
+         * @brief Get the number of remaining source elements
+         * @return Number of remaining source elements
+         */
+        size_t size() const { return m_parent.size(); }
+
+        /**
+         * @brief Create a stage iterating over a range of the remaining source elements
+         * @param begin Index of the first source element
+         * @param end Index after the last source element
+         * @return Stage restricted to the given range
+         */
+        StaticFilter slice(size_t begin, size_t end) const {
+            return StaticFilter(m_parent.slice(begin, end), m_filter);
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Upper bound of the parent stage
+         */
+        SizeHint sizeHint() const { return m_parent.sizeHint().atMost(); }
+
+      private:
+        // Parent stage
+        Parent m_parent;
+        // Filter callable
+        Filter m_filter;
+    };
+
+    /**
+     * @brief Static stage enumerating the elements of its parent stage
+     * @typeparam Parent Type of the parent stage
+     */
+    template <typename Parent>
+    class StaticEnumerate {
+      public:
+        /**
+         * @brief Type of the enumerated elements
+         */
+        using OutputType = std::pair<size_t, typename Parent::OutputType>;
+
+        /**
+         * @brief True if the stage can be split into independent ranges of the source
+         * @details Global indices are only known if every source element results in exactly one parent element.
+         */
+        static constexpr bool Splittable = Parent::Splittable && Parent::Preserving;
+
+        /**
+         * @brief True if every source element results in exactly one output element
+         */
+        static constexpr bool Preserving = Parent::Preserving;
+
+        /**
+         * @brief Construct a new StaticEnumerate object
+         * @param parent The parent stage
+         * @param index Index of the first element
+         */
+        StaticEnumerate(Parent parent, size_t index = 0) : m_index(index), m_parent(std::move(parent)) {}
+
+        /**
+         * @brief Get the next enumerated element
+         * @return Next enumerated element or None if the end is reached
+         */
+        Option<OutputType> next() {
+            Option<typename Parent::OutputType> opt = m_parent.next();
+            if (opt.isNone()) {
+                return Option<OutputType>();
+            } else {
+                return Option<OutputType>(OutputType(m_index++, std::move(opt.get())));
+            }
+        }
+
+        /**
+         * @brief Get the number of remaining source elements
+         * @return Number of remaining source elements
+         */
+        size_t size() const { return m_parent.size(); }
+
+        /**
+         * @brief Create a stage iterating over a range of the remaining source elements
+         * @param begin Index of the first source element
+         * @param end Index after the last source element
+         * @return Stage restricted to the given range
+         */
+        StaticEnumerate slice(size_t begin, size_t end) const {
+            return StaticEnumerate(m_parent.slice(begin, end), m_index + begin);
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the parent stage
+         */
+        SizeHint sizeHint() const { return m_parent.sizeHint(); }
+
+      private:
+        // Enumerater
+        size_t m_index;
+        // Parent stage
+        Parent m_parent;
+    };
+
+    /**
+     * @brief Static stage iterating over two stages simultaneously
+     * @typeparam First Type of the first stage
+     * @typeparam Second Type of the second stage
+     */
+    template <typename First, typename Second>
+    class StaticZip {
+      public:
+        /**
+         * @brief Type of the zipped elements
+         */
+        using OutputType = std::pair<typename First::OutputType, typename Second::OutputType>;
+
+        /**
+         * @brief True if the stage can be split into independent ranges of the source
+         * @details Both stages are only aligned if every source element results in exactly one element.
+         */
+        static constexpr bool Splittable =
+            First::Splittable && Second::Splittable && First::Preserving && Second::Preserving;
+
+        /**
+         * @brief True if every source element results in exactly one output element
+         */
+        static constexpr bool Preserving = First::Preserving && Second::Preserving;
+
+        /**
+         * @brief Construct a new StaticZip object
+         * @param first The first stage
+         * @param second The second stage
+         */
+        StaticZip(First first, Second second) : m_first(std::move(first)), m_second(std::move(second)) {}
+
+        /**
+         * @brief Get the next zipped element
+         * @return Next zipped element or None if one of both stages reached its end
+         */
+        Option<OutputType> next() {
+            Option<typename First::OutputType> f = m_first.next();
+            if (f.isNone()) {
+                return Option<OutputType>();
+            }
+            Option<typename Second::OutputType> s = m_second.next();
+            if (s.isNone()) {
+                return Option<OutputType>();
+            }
+            return Option<OutputType>(OutputType(std::move(f.get()), std::move(s.get())));
+        }
+
+        /**
+         * @brief Get the number of remaining source elements
+         * @return Number of remaining source elements of the shorter stage
+         */
+        size_t size() const { return std::min(m_first.size(), m_second.size()); }
+
+        /**
+         * @brief Create a stage iterating over a range of the remaining source elements
+         * @param begin Index of the first source element
+         * @param end Index after the last source element
+         * @return Stage restricted to the given range
+         */
+        StaticZip slice(size_t begin, size_t end) const {
+            return StaticZip(m_first.slice(begin, end), m_second.slice(begin, end));
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Minimum of the bounds of both stages
+         */
+        SizeHint sizeHint() const { return m_first.sizeHint().min(m_second.sizeHint()); }
+
+      private:
+        // First stage
+        First m_first;
+        // Second stage
+        Second m_second;
+    };
+
+    /**
+     * @brief Adapter exposing a static stage through the iterator interface
+     * @typeparam Stage Type of the wrapped stage
+     */
+    template <typename Stage>
+    class StaticAdapter : public IIterator<typename Stage::OutputType> {
+      public:
+        /**
+         * @brief Construct a new StaticAdapter object
+         * @param stage The stage to expose
+         */
+        StaticAdapter(Stage stage) : m_stage(std::move(stage)) {}
+
+        /**
+         * @brief Get the next element of the wrapped stage
+         * @return Next element or None if the end is reached
+         */
+        Option<typename Stage::OutputType> next() override { return m_stage.next(); }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the wrapped stage
+         */
+        SizeHint sizeHint() const override { return m_stage.sizeHint(); }
+
+      private:
+        // Wrapped stage
+        Stage m_stage;
+    };
+
+    /**
+     * @brief Wrapper class for statically composed pipelines
+     * @details All stages are stored by value and are templated on the exact callable type. Thus, the compiler is able
+     * to inline the whole chain into a single loop. Use into() to get a type-erased iterator if needed.
+     * @typeparam Stage Type of the last stage of the pipeline
+     */
+    template <typename Stage>
+    class StaticWrapper {
+      public:
+        /**
+         * @brief Type of the elements yielded by the pipeline
+         */
+        using OutputType = typename Stage::OutputType;
+
+        /**
+         * @brief Type of the keys computed by a key function of the aggregations
+         * @typeparam KeyFunction Type of the key function
+         */
+        template <typename KeyFunction>
+        using KeyType = std::remove_cv_t<std::remove_reference_t<std::invoke_result_t<KeyFunction, OutputType &>>>;
+
+        /**
+         * @brief Create new static wrapper from a stage
+         * @param stage Stage to wrap
+         */
+        StaticWrapper(Stage stage) : m_stage(std::move(stage)) {}
+
+        /**
+         * @brief Create zipped pipeline from this and another static pipeline
+         * @param other Pipeline to zip with
+         * @return Zipped pipeline
+         */
+        template <typename OtherStage>
+        StaticWrapper<StaticZip<Stage, OtherStage>> zip(StaticWrapper<OtherStage> other) {
+            return StaticWrapper<StaticZip<Stage, OtherStage>>(StaticZip<Stage, OtherStage>(m_stage, other.inner()));
+        }
+
+        /**
+         * @brief Create enumerated pipeline from this
+         * @return Enumerated pipeline
+         */
+        StaticWrapper<StaticEnumerate<Stage>> enumerate() {
+            return StaticWrapper<StaticEnumerate<Stage>>(StaticEnumerate<Stage>(m_stage));
+        }
+
+        /**
+         * @brief Create filtered pipeline from this and a filter
+         * @param filter Filter to apply
+         * @return Filtered pipeline
+         */
+        template <typename Filter>
+        StaticWrapper<StaticFilter<Stage, Filter>> filter(Filter filter) {
+            return StaticWrapper<StaticFilter<Stage, Filter>>(StaticFilter<Stage, Filter>(m_stage, std::move(filter)));
+        }
+
+        /**
+         * @brief Create mapped pipeline from this and a map
+         * @typeparam OtherOutputType Output type of the mapped values, deduced from the map if omitted
+         * @param map Mapping to apply to each element
+         * @return Mapped pipeline
+         */
+        template <typename OtherOutputType = void, typename Map>
+        StaticWrapper<StaticMap<Stage, Map, OtherOutputType>> map(Map map) {
+            return StaticWrapper<StaticMap<Stage, Map, OtherOutputType>>(
+                StaticMap<Stage, Map, OtherOutputType>(m_stage, std::move(map)));
+        }
+
+        /**
+         * @brief Execute the terminal operation of the pipeline in parallel on the global thread pool
+         * @return Parallel pipeline
+         */
+        ParallelWrapper<Stage> par() { return ParallelWrapper<Stage>(m_stage, ThreadPool::global()); }
+
+        /**
+         * @brief Execute the terminal operation of the pipeline in parallel on the given thread pool
+         * @param pool Thread pool to execute the pipeline on
+         * @return Parallel pipeline
+         */
+        ParallelWrapper<Stage> par(ThreadPool &pool) { return ParallelWrapper<Stage>(m_stage, pool); }
+
+        /**
+         * @brief Transform this wrapper into wrapper of iterator interface
+         * @return Wrapper of iterator interface
+         */
+        IteratorWrapper<IIterator<OutputType>, OutputType> into() {
+            return IteratorWrapper<IIterator<OutputType>, OutputType>(std::make_shared<StaticAdapter<Stage>>(m_stage));
+        }
+
+        /**
+         * @brief Print all elements of the pipeline
+         */
+        void print() {
+            std::cout << "{ ";
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                std::cout << opt.get() << ", ";
+                opt = m_stage.next();
+            }
+            std::cout << "}" << std::endl;
+        }
+
+        /**
+         * @brief Returns the product of all elements
+         * @return Product of all elements based on operator*, None if no elements
+         */
+        Option<OutputType> product() {
+            Option<OutputType> prod = m_stage.next();
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                prod.get() *= opt.get();
+                opt = m_stage.next();
+            }
+            return prod;
+        }
+
+        /**
+         * @brief Returns the sum of all elements
+         * @return Sum of all elements based on operator+, None if no elements
+         */
+        Option<OutputType> sum() {
+            Option<OutputType> s = m_stage.next();
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                s.get() += opt.get();
+                opt = m_stage.next();
+            }
+            return s;
+        }
+
+        /**
+         * @brief Collects all values of the pipeline into a container
+         * @typeparam Collection Type of the container
+         * @return Container with all values of the pipeline
+         */
+        template <typename Collection>
+        Collection collectInsert() {
+            Collection c;
+            reserve(c, m_stage.sizeHint());
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                c.insert(std::move(opt.get()));
+                opt = m_stage.next();
+            }
+            return c;
+        }
+
+        /**
+         * @brief Collects all values of the pipeline into a container
+         * @typeparam Collection Type of the container
+         * @return Container with all values of the pipeline
+         */
+        template <typename Collection>
+        Collection collectPush() {
+            Collection c;
+            reserve(c, m_stage.sizeHint());
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                c.push_back(std::move(opt.get()));
+                opt = m_stage.next();
+            }
+            return c;
+        }
+
+        /**
+         * @brief Group all values by a key
+         * @typeparam KeyFunction Type of the key function
+         * @param key Function computing the key of a value
+         * @param expected Expected number of keys, 0 to size the table from the size hint
+         * @return Table of the values of each key in the order of the pipeline
+         */
+        template <typename KeyFunction>
+        FlatHashMap<KeyType<KeyFunction>, std::vector<OutputType>> groupBy(KeyFunction key, size_t expected = 0) {
+            FlatHashMap<KeyType<KeyFunction>, std::vector<OutputType>> table(
+                expectedKeys(m_stage.sizeHint(), expected));
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                table.tryEmplace(key(opt.get())).first->push_back(std::move(opt.get()));
+                opt = m_stage.next();
+            }
+            return table;
+        }
+
+        /**
+         * @brief Reduce all values with the same key
+         * @details The first value of a key is the initial accumulator, all further values are combined into it with
+         * combine(accumulator, value).
+         * @typeparam KeyFunction Type of the key function
+         * @typeparam Combine Type of the combine function
+         * @param key Function computing the key of a value
+         * @param combine Function combining a value into the accumulator of its key
+         * @param expected Expected number of keys, 0 to size the table from the size hint
+         * @return Table of the accumulator of each key
+         */
+        template <typename KeyFunction, typename Combine>
+        FlatHashMap<KeyType<KeyFunction>, OutputType> reduceByKey(KeyFunction key, Combine combine,
+                                                                  size_t expected = 0) {
+            FlatHashMap<KeyType<KeyFunction>, OutputType> table(expectedKeys(m_stage.sizeHint(), expected));
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                std::pair<OutputType *, bool> result = table.tryEmplace(key(opt.get()), std::move(opt.get()));
+                if (!result.second) {
+                    combine(*result.first, opt.get());
+                }
+                opt = m_stage.next();
+            }
+            return table;
+        }
+
+        /**
+         * @brief Count the values of each key
+         * @typeparam KeyFunction Type of the key function
+         * @param key Function computing the key of a value
+         * @param expected Expected number of keys, 0 to size the table from the size hint
+         * @return Table of the number of values of each key
+         */
+        template <typename KeyFunction>
+        FlatHashMap<KeyType<KeyFunction>, size_t> countBy(KeyFunction key, size_t expected = 0) {
+            FlatHashMap<KeyType<KeyFunction>, size_t> table(expectedKeys(m_stage.sizeHint(), expected));
+            Option<OutputType> opt = m_stage.next();
+            while (opt.isSome()) {
+                ++*table.tryEmplace(key(opt.get())).first;
+                opt = m_stage.next();
+            }
+            return table;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Bounds of the number of remaining elements
+         */
+        SizeHint sizeHint() const { return m_stage.sizeHint(); }
+
+        /**
+         * @brief Return copy of the inner stage
+         * @return Copy of the inner stage
+         */
+        Stage inner() { return m_stage; }
+
+      private:
+        // Last stage of the pipeline
+        Stage m_stage;
+    };
+
+} // namespace itertools
+
+#endif
@@ -0,0 +1,292 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_STATS_HXX_
+#define _ITERTOOLS_STATS_HXX_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace itertools {
+    /**
+     * @brief Whether the iterators record statistics, enabled by defining ITERTOOLS_STATS before the first include
+     */
+#ifdef ITERTOOLS_STATS
+    constexpr bool StatsEnabled = true;
+#else
+    constexpr bool StatsEnabled = false;
+#endif
+
+    /**
+     * @brief Statistics recorded by a single stage of an iterator chain
+     */
+    struct StageStats {
+        // Name of the stage
+        std::string name;
+        // Number of calls to next()
+        size_t nextCalls = 0;
+        // Number of calls to nextBatch()
+        size_t batchCalls = 0;
+        // Number of elements pulled from the parent, pairs for zip stages
+        size_t pulled = 0;
+        // Number of elements yielded by the stage
+        size_t yielded = 0;
+        // Estimated time spent in the stage including its parents
+        double seconds = 0.0;
+        // Estimated time spent in the stage without its parents
+        double selfSeconds = 0.0;
+
+        /**
+         * @brief Get the fraction of pulled elements yielded by the stage
+         * @return Yielded divided by pulled elements, 1 if nothing was pulled
+         */
+        double selectivity() const {
+            return pulled == 0 ? 1.0 : static_cast<double>(yielded) / static_cast<double>(pulled);
+        }
+    };
+
+    /**
+     * @brief Statistics of all stages of an iterator chain, ordered from the sources to the last stage
+     */
+    class StatsReport {
+      public:
+        /**
+         * @brief Append the statistics of a stage
+         * @param stats Statistics of the stage
+         */
+        void add(StageStats stats) { m_stages.push_back(std::move(stats)); }
+
+        /**
+         * @brief Get the statistics of all stages, e.g. to export them to a metrics system
+         * @return Statistics of all stages
+         */
+        std::vector<StageStats> const &stages() const { return m_stages; }
+
+        /**
+         * @brief Format the report as a table
+         * @return Text of the report
+         */
+        std::string toText() const {
+            std::ostringstream stream;
+            stream << std::left << std::setw(12) << "stage" << std::right << std::setw(12) << "next" << std::setw(10)
+                   << "batches" << std::setw(12) << "pulled" << std::setw(12) << "yielded" << std::setw(12)
+                   << "selectivity" << std::setw(12) << "time [ms]" << std::setw(12) << "self [ms]" << "\n";
+            stream << std::fixed;
+            for (StageStats const &stage : m_stages) {
+                stream << std::left << std::setw(12) << stage.name << std::right << std::setw(12) << stage.nextCalls
+                       << std::setw(10) << stage.batchCalls << std::setw(12) << stage.pulled << std::setw(12)
+                       << stage.yielded << std::setw(12) << std::setprecision(4) << stage.selectivity()
+                       << std::setw(12) << std::setprecision(3) << stage.seconds * 1e3 << std::setw(12)
+                       << stage.selfSeconds * 1e3 << "\n";
+            }
+            return stream.str();
+        }
+
+        /**
+         * @brief Format the report as JSON
+         * @return JSON object of the report
+         */
+        std::string toJson() const {
+            std::ostringstream stream;
+            stream << "{\"enabled\": " << (StatsEnabled ? "true" : "false") << ", \"stages\": [";
+            for (size_t i = 0; i < m_stages.size(); ++i) {
+                StageStats const &stage = m_stages[i];
+                stream << (i == 0 ? "" : ", ") << "{\"name\": \"" << stage.name
+                       << "\", \"next_calls\": " << stage.nextCalls << ", \"batch_calls\": " << stage.batchCalls
+                       << ", \"pulled\": " << stage.pulled << ", \"yielded\": " << stage.yielded
+                       << ", \"selectivity\": " << stage.selectivity() << ", \"seconds\": " << stage.seconds
+                       << ", \"self_seconds\": " << stage.selfSeconds << "}";
+            }
+            stream << "]}";
+            return stream.str();
+        }
+
+      private:
+        // Statistics of the stages
+        std::vector<StageStats> m_stages;
+    };
+
+#ifdef ITERTOOLS_STATS
+    /**
+     * @brief Counters of a single stage
+     * @details Every batch is timed, single elements only every SampleInterval-th call to keep the overhead of the
+     * clock small compared to cheap stages. The time of all calls is extrapolated from the sampled ones.
+     * The counters are only written by the thread running the stage, but may be read by another thread while an
+     * asynchronous stage is producing. Thus, they are relaxed atomics updated by a plain load and store.
+     */
+    class StageCounter {
+      public:
+        /**
+         * @brief Number of next() calls per timed call
+         */
+        static constexpr size_t SampleInterval = 64;
+
+        /**
+         * @brief Measures the time of a call if it is sampled
+         */
+        class Scope {
+          public:
+            /**
+             * @brief Start measuring a call
+             * @param time Time to add the measured time to, nullptr if the call isn't sampled
+             */
+            Scope(std::atomic<double> *time) : m_time(time) {
+                if (m_time) {
+                    m_start = std::chrono::steady_clock::now();
+                }
+            }
+
+            Scope(Scope const &) = delete;
+            Scope &operator=(Scope const &) = delete;
+
+            /**
+             * @brief Stop measuring the call
+             */
+            ~Scope() {
+                if (m_time) {
+                    add(*m_time, std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count());
+                }
+            }
+
+          private:
+            // Time to add the measured time to
+            std::atomic<double> *m_time;
+            // Start of the call
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+        /**
+         * @brief Count a call to next()
+         * @return Scope measuring the call
+         */
+        Scope next() {
+            bool sampled = m_nextCalls.load(std::memory_order_relaxed) % SampleInterval == 0;
+            add(m_nextCalls, size_t(1));
+            if (sampled) {
+                add(m_nextSamples, size_t(1));
+            }
+            return Scope(sampled ? &m_nextTime : nullptr);
+        }
+
+        /**
+         * @brief Count a call to nextBatch()
+         * @return Scope measuring the call
+         */
+        Scope batch() {
+            add(m_batchCalls, size_t(1));
+            return Scope(&m_batchTime);
+        }
+
+        /**
+         * @brief Count elements pulled from the parent
+         * @param count Number of elements
+         */
+        void pulled(size_t count) { add(m_pulled, count); }
+
+        /**
+         * @brief Count elements yielded by the stage
+         * @param count Number of elements
+         */
+        void yielded(size_t count) { add(m_yielded, count); }
+
+        /**
+         * @brief Append the statistics of the stage to a report
+         * @param report Report to append to
+         * @param name Name of the stage
+         * @param parentSeconds Time spent in the parents of the stage
+         * @return Estimated time spent in the stage including its parents
+         */
+        double report(StatsReport &report, char const *name, double parentSeconds) const {
+            StageStats stats;
+            stats.name = name;
+            stats.nextCalls = m_nextCalls.load(std::memory_order_relaxed);
+            stats.batchCalls = m_batchCalls.load(std::memory_order_relaxed);
+            stats.pulled = m_pulled.load(std::memory_order_relaxed);
+            stats.yielded = m_yielded.load(std::memory_order_relaxed);
+            stats.seconds = m_batchTime.load(std::memory_order_relaxed);
+            size_t nextSamples = m_nextSamples.load(std::memory_order_relaxed);
+            if (nextSamples != 0) {
+                stats.seconds += m_nextTime.load(std::memory_order_relaxed) * static_cast<double>(stats.nextCalls) /
+                                 static_cast<double>(nextSamples);
+            }
+            stats.selfSeconds = stats.seconds > parentSeconds ? stats.seconds - parentSeconds : 0.0;
+            report.add(stats);
+            return stats.seconds;
+        }
+
+      private:
+        /**
+         * @brief Add to a counter only written by the calling thread
+         * @param counter Counter to add to
+         * @param value Value to add
+         */
+        template <typename CounterType>
+        static void add(std::atomic<CounterType> &counter, CounterType value) {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        // Number of calls to next()
+        std::atomic<size_t> m_nextCalls{0};
+        // Number of timed calls to next()
+        std::atomic<size_t> m_nextSamples{0};
+        // Time of the timed calls to next()
+        std::atomic<double> m_nextTime{0.0};
+        // Number of calls to nextBatch()
+        std::atomic<size_t> m_batchCalls{0};
+        // Time of all calls to nextBatch()
+        std::atomic<double> m_batchTime{0.0};
+        // Number of elements pulled from the parent
+        std::atomic<size_t> m_pulled{0};
+        // Number of elements yielded by the stage
+        std::atomic<size_t> m_yielded{0};
+    };
+#else
+    /**
+     * @brief Counters of a single stage, compiled out because ITERTOOLS_STATS is not defined
+     */
+    class StageCounter {
+      public:
+        /**
+         * @brief Empty scope of a call
+         */
+        class Scope {
+          public:
+            ~Scope() {}
+        };
+
+        Scope next() { return Scope(); }
+        Scope batch() { return Scope(); }
+        void pulled(size_t) {}
+        void yielded(size_t) {}
+        double report(StatsReport &, char const *, double) const { return 0.0; }
+    };
+#endif
+
+} // namespace itertools
+
+#endif
@@ -0,0 +1,397 @@
+// MIT License
+//
+// Copyright (c) 2022 David Loewe
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef _ITERTOOLS_TABLE_HXX_
+#define _ITERTOOLS_TABLE_HXX_
+
+#include "hint.hxx"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace itertools {
+    /**
+     * @brief Maximal number of keys reserved up front from the size hint by the aggregations
+     */
+    constexpr size_t MaxHintedKeys = size_t(1) << 16;
+
+    /**
+     * @brief Get the number of keys to reserve for an aggregation
+     * @details The number of elements is only an upper bound of the number of keys. Thus, the reservation based on
+     * the size hint is capped to keep aggregations with few keys small.
+     * @param hint Hint of the number of aggregated elements
+     * @param expected Number of keys given by the user, 0 if unknown
+     * @return Number of keys to reserve
+     */
+    inline size_t expectedKeys(SizeHint const &hint, size_t expected) {
+        return expected != 0 ? expected : std::min(hint.lower(), MaxHintedKeys);
+    }
+
+    /**
+     * @brief Iterator over the entries of a FlatHashMap exposing their keys as const
+     * @details The entries are stored as std::pair<Key, Value>, so they are moved when reallocated. They are exposed
+     * as std::pair<Key const, Value> with the same layout, like node-based maps of the standard libraries do.
+     * @typeparam Entry Type of the stored entries, const for constant iterators
+     * @typeparam Exposed Type of the exposed entries, const for constant iterators
+     */
+    template <typename Entry, typename Exposed>
+    class FlatHashMapIterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<Exposed>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Exposed *;
+        using reference = Exposed &;
+
+        /**
+         * @brief Create a new iterator
+         * @param entry Pointer to the entry
+         */
+        FlatHashMapIterator(Entry *entry = nullptr) : m_entry(entry) {}
+
+        /**
+         * @brief Convert a mutable to a constant iterator
+         * @param other Mutable iterator
+         */
+        template <typename OtherEntry, typename OtherExposed,
+                  typename = std::enable_if_t<std::is_convertible_v<OtherEntry *, Entry *>>>
+        FlatHashMapIterator(FlatHashMapIterator<OtherEntry, OtherExposed> const &other) : m_entry(other.entry()) {}
+
+        reference operator*() const { return *reinterpret_cast<pointer>(m_entry); }
+        pointer operator->() const { return reinterpret_cast<pointer>(m_entry); }
+
+        FlatHashMapIterator &operator++() {
+            ++m_entry;
+            return *this;
+        }
+
+        FlatHashMapIterator operator++(int) {
+            FlatHashMapIterator previous = *this;
+            ++m_entry;
+            return previous;
+        }
+
+        bool operator==(FlatHashMapIterator const &other) const { return m_entry == other.m_entry; }
+        bool operator!=(FlatHashMapIterator const &other) const { return m_entry != other.m_entry; }
+
+        /**
+         * @brief Get the stored entry
+         * @return Pointer to the entry
+         */
+        Entry *entry() const { return m_entry; }
+
+      private:
+        // Pointer to the entry
+        Entry *m_entry;
+    };
+
+    /**
+     * @brief Insert-only hash map with open addressing
+     * @details The entries are stored densely in insertion order. A separate power-of-two sized bucket array, probed
+     * linearly, holds the hash and position of each entry, so probing rarely touches the entries themselves. Entries
+     * can't be erased, which avoids tombstones. The keys are only exposed as const like in std::unordered_map, but
+     * stored mutable, so the entries are moved when reallocated or merged.
+     * @typeparam Key Type of the keys
+     * @typeparam Value Type of the values
+     * @typeparam Hash Hash function of the keys
+     * @typeparam Equal Equality of the keys
+     */
+    template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+    class FlatHashMap {
+      public:
+        /**
+         * @brief Type of the entries, the keys can't be changed as that would break the buckets
+         */
+        using value_type = std::pair<Key const, Value>;
+
+        /**
+         * @brief Iterator over the entries in insertion order
+         */
+        using iterator = FlatHashMapIterator<std::pair<Key, Value>, value_type>;
+
+        /**
+         * @brief Constant iterator over the entries in insertion order
+         */
+        using const_iterator = FlatHashMapIterator<std::pair<Key, Value> const, value_type const>;
+
+        /**
+         * @brief Minimal number of buckets
+         */
+        static constexpr size_t MinBuckets = 8;
+
+        /**
+         * @brief Create a new map
+         * @param count Number of entries to reserve space for
+         */
+        FlatHashMap(size_t count = 0) : m_shift(64) { reserve(count); }
+
+        /**
+         * @brief Get the number of entries
+         * @return Number of entries
+         */
+        size_t size() const { return m_entries.size(); }
+
+        /**
+         * @brief Check whether the map has no entries
+         * @return True if empty, false otherwise
+         */
+        bool empty() const { return m_entries.empty(); }
+
+        /**
+         * @brief Get the number of buckets
+         * @return Number of buckets
+         */
+        size_t bucketCount() const { return m_buckets.size(); }
+
+        /**
+         * @brief Reserve space for entries, so inserting them doesn't rehash
+         * @param count Number of entries
+         */
+        void reserve(size_t count) {
+            m_entries.reserve(count);
+            size_t buckets = std::max(m_buckets.size(), MinBuckets);
+            while (count * 4 > buckets * 3) {
+                buckets *= 2;
+            }
+            if (count != 0 && buckets != m_buckets.size()) {
+                rehash(buckets);
+            }
+        }
+
+        iterator begin() { return iterator(m_entries.data()); }
+        iterator end() { return iterator(m_entries.data() + m_entries.size()); }
+        const_iterator begin() const { return const_iterator(m_entries.data()); }
+        const_iterator end() const { return const_iterator(m_entries.data() + m_entries.size()); }
+
+        /**
+         * @brief Find the value of a key
+         * @param key Key to find
+         * @return Pointer to the value, nullptr if the key isn't found
+         */
+        Value *find(Key const &key) {
+            size_t entry = position(key, mix(key));
+            return entry == Empty ? nullptr : &m_entries[entry].second;
+        }
+
+        /**
+         * @brief Find the value of a key
+         * @param key Key to find
+         * @return Pointer to the value, nullptr if the key isn't found
+         */
+        Value const *find(Key const &key) const {
+            size_t entry = position(key, mix(key));
+            return entry == Empty ? nullptr : &m_entries[entry].second;
+        }
+
+        /**
+         * @brief Check whether the map contains a key
+         * @param key Key to check
+         * @return True if found, false otherwise
+         */
+        bool contains(Key const &key) const { return find(key) != nullptr; }
+
+        /**
+         * @brief Get the value of a key
+         * @param key Key to find
+         * @return Value of the key
+         * @throws std::out_of_range If the key isn't found
+         */
+        Value &at(Key const &key) {
+            Value *value = find(key);
+            if (!value) {
+                throw std::out_of_range("key not found");
+            }
+            return *value;
+        }
+
+        /**
+         * @brief Get the value of a key
+         * @param key Key to find
+         * @return Value of the key
+         * @throws std::out_of_range If the key isn't found
+         */
+        Value const &at(Key const &key) const {
+            Value const *value = find(key);
+            if (!value) {
+                throw std::out_of_range("key not found");
+            }
+            return *value;
+        }
+
+        /**
+         * @brief Get the value of a key, inserting a value-initialized one if the key isn't found
+         * @param key Key to find
+         * @return Value of the key
+         */
+        Value &operator[](Key const &key) { return *tryEmplace(key).first; }
+
+        /**
+         * @brief Insert a key if it isn't found
+         * @details The arguments are only used if the key is inserted. The returned pointer is valid until the next
+         * insertion.
+         * @param key Key to find or insert
+         * @param args Arguments to construct the value of an inserted key from
+         * @return Pointer to the value of the key and whether it was inserted
+         */
+        template <typename KeyType, typename... Args>
+        std::pair<Value *, bool> tryEmplace(KeyType &&key, Args &&...args) {
+            uint64_t hash = mix(key);
+            size_t index = bucket(key, hash);
+            if (index != Empty && m_buckets[index].entry != Empty) {
+                return std::make_pair(&m_entries[m_buckets[index].entry].second, false);
+            }
+            if ((m_entries.size() + 1) * 4 > m_buckets.size() * 3) {
+                rehash(std::max(m_buckets.size() * 2, MinBuckets));
+                index = bucket(key, hash);
+            }
+            m_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyType>(key)),
+                                   std::forward_as_tuple(std::forward<Args>(args)...));
+            m_buckets[index] = Bucket{hash, m_entries.size() - 1};
+            return std::make_pair(&m_entries.back().second, true);
+        }
+
+        /**
+         * @brief Move all entries of another map into this one
+         * @details Entries of new keys are appended in the order of the other map. The values of existing keys are
+         * combined with combine(value, otherValue).
+         * @param other Map to merge
+         * @param combine Function combining the values of a key found in both maps
+         */
+        template <typename Combine>
+        void merge(FlatHashMap &&other, Combine combine) {
+            for (std::pair<Key, Value> &entry : other.m_entries) {
+                std::pair<Value *, bool> result = tryEmplace(std::move(entry.first), std::move(entry.second));
+                if (!result.second) {
+                    combine(*result.first, entry.second);
+                }
+            }
+            other.m_entries.clear();
+            other.m_buckets.clear();
+            other.m_shift = 64;
+        }
+
+      private:
+        /**
+         * @brief Bucket referring to an entry
+         */
+        struct Bucket {
+            // Mixed hash of the key
+            uint64_t hash;
+            // Position of the entry, Empty if the bucket is unused
+            size_t entry;
+        };
+
+        /**
+         * @brief Position of unused buckets
+         */
+        static constexpr size_t Empty = static_cast<size_t>(-1);
+
+        /**
+         * @brief Hash a key and spread the bits by Fibonacci hashing, so the high bits are usable as bucket index
+         * @param key Key to hash
+         * @return Mixed hash
+         */
+        template <typename KeyType>
+        uint64_t mix(KeyType const &key) const {
+            return static_cast<uint64_t>(m_hash(key)) * UINT64_C(0x9E3779B97F4A7C15);
+        }
+
+        /**
+         * @brief Find the bucket of a key
+         * @param key Key to find
+         * @param hash Mixed hash of the key
+         * @return Index of the bucket referring to the key or of the unused bucket ending the probing, Empty if there
+         * are no buckets
+         */
+        template <typename KeyType>
+        size_t bucket(KeyType const &key, uint64_t hash) const {
+            if (m_buckets.empty()) {
+                return Empty;
+            }
+            size_t mask = m_buckets.size() - 1;
+            size_t index = static_cast<size_t>(hash >> m_shift);
+            while (m_buckets[index].entry != Empty) {
+                Bucket const &bucket = m_buckets[index];
+                if (bucket.hash == hash && m_equal(m_entries[bucket.entry].first, key)) {
+                    break;
+                }
+                index = (index + 1) & mask;
+            }
+            return index;
+        }
+
+        /**
+         * @brief Find the position of the entry of a key
+         * @param key Key to find
+         * @param hash Mixed hash of the key
+         * @return Position of the entry, Empty if the key isn't found
+         */
+        size_t position(Key const &key, uint64_t hash) const {
+            size_t index = bucket(key, hash);
+            return index == Empty ? Empty : m_buckets[index].entry;
+        }
+
+        /**
+         * @brief Rebuild the buckets with a new number of buckets, reusing the stored hashes
+         * @param count Number of buckets, a power of two
+         */
+        void rehash(size_t count) {
+            std::vector<Bucket> buckets(count, Bucket{0, Empty});
+            size_t shift = 64;
+            for (size_t n = count; n > 1; n >>= 1) {
+                --shift;
+            }
+            for (Bucket const &bucket : m_buckets) {
+                if (bucket.entry != Empty) {
+                    size_t index = static_cast<size_t>(bucket.hash >> shift);
+                    while (buckets[index].entry != Empty) {
+                        index = (index + 1) & (count - 1);
+                    }
+                    buckets[index] = bucket;
+                }
+            }
+            m_buckets.swap(buckets);
+            m_shift = shift;
+        }
+
+        // Entries in insertion order
+        std::vector<std::pair<Key, Value>> m_entries;
+        // Buckets referring to the entries
+        std::vector<Bucket> m_buckets;
+        // Shift of the mixed hash to get the bucket index
+        unsigned m_shift;
+        // Hash function of the keys
+        Hash m_hash;
+        // Equality of the keys
+        Equal m_equal;
+    };
+
+} // namespace itertools
+
+#endif
@@ -23,9 +23,58 @@
 #ifndef _ITERTOOLS_TYPES_HXX_
 #define _ITERTOOLS_TYPES_HXX_
 
+#include "hint.hxx"
 #include "optional.hxx"
+#include "stats.hxx"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace itertools {
+    /**
+     * @brief Element type of a batch buffer
+     * @typeparam ValueType The type of the elements
+     */
+    template <typename ValueType>
+    struct BatchElement {
+        using Type = ValueType;
+    };
+
+    /**
+     * @brief Element type of a batch buffer of references
+     * @typeparam ValueType The type of the referenced elements
+     */
+    template <typename ValueType>
+    struct BatchElement<ValueType &> {
+        using Type = std::reference_wrapper<ValueType>;
+    };
+
+    /**
+     * @brief Type owning the data of an element, so it stays valid after the next pull
+     * @typeparam ValueType The type of the elements
+     */
+    template <typename ValueType>
+    struct OwnedElement {
+        using Type = ValueType;
+    };
+
+    /**
+     * @brief Views of file sources are only valid until the next pull, thus they are owned as strings
+     */
+    template <>
+    struct OwnedElement<std::string_view> {
+        using Type = std::string;
+    };
+
+    /**
+     * @brief Buffer used to pull elements in batches
+     * @typeparam ValueType The type of the elements
+     */
+    template <typename ValueType>
+    using Batch = std::vector<typename BatchElement<ValueType>::Type>;
+
     /**
      * @brief Basic iterator interface
      * @typeparam ValueType The type of the elements
@@ -35,6 +84,56 @@ namespace itertools {
       public:
         virtual Option<ValueType> next() = 0;
         virtual ~IIterator() = default;
+
+        /**
+         * @brief Append the next elements to the given buffer
+         * @details The default implementation pulls the elements one by one using next().
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        virtual size_t nextBatch(Batch<ValueType> &buffer, size_t maxCount) {
+            size_t count = 0;
+            while (count < maxCount) {
+                Option<ValueType> opt = next();
+                if (opt.isNone()) {
+                    break;
+                }
+                buffer.push_back(opt.take());
+                ++count;
+            }
+            return count;
+        }
+
+        /**
+         * @brief Skip the next elements
+         * @details The default implementation pulls and discards the elements one by one using next().
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        virtual size_t advanceBy(size_t count) {
+            size_t skipped = 0;
+            while (skipped < count && next().isSome()) {
+                ++skipped;
+            }
+            return skipped;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @details The default implementation doesn't know anything about the number of elements.
+         * @return Bounds of the number of remaining elements
+         */
+        virtual SizeHint sizeHint() const { return SizeHint(); }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @details The default implementation records nothing. Statistics are only recorded if ITERTOOLS_STATS is
+         * defined.
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        virtual double collectStats(StatsReport &) const { return 0.0; }
     };
 
     /**
@@ -54,8 +153,9 @@ namespace itertools {
     /**
      * @brief Basic iterator class for iterating over a container.
      * @typeparam C Container type.
+     * @typeparam ValueType Type of the yielded elements, a reference to borrow the elements.
      */
-    template <typename Container>
+    template <typename Container, typename ValueType = typename Container::value_type>
     class BasicIterator;
 
     /**
@@ -88,6 +188,41 @@ namespace itertools {
     template <typename OutputType>
     class EnumerateIterator;
 
+    /**
+     * @brief Iterator skipping the first elements of an iterator
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class SkipIterator;
+
+    /**
+     * @brief Iterator yielding only the first elements of an iterator
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class TakeIterator;
+
+    /**
+     * @brief Iterator yielding every n-th element of an iterator
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class StepByIterator;
+
+    /**
+     * @brief Iterator yielding the elements of an iterator in chunks
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class ChunksIterator;
+
+    /**
+     * @brief Iterator running its upstream chain on separate threads
+     * @typeparam ValueType Type of the elements
+     */
+    template <typename ValueType>
+    class AsyncIterator;
+
     /**
      * @brief Wrapper for iterator handling
      * @typeparam IteratorType Type of the iterator
@@ -96,6 +231,39 @@ namespace itertools {
     template <typename IteratorType, typename OutputType>
     class IteratorWrapper;
 
+    /**
+     * @brief Static source stage iterating over a container
+     * @typeparam Container Container type
+     */
+    template <typename Container>
+    class StaticBasic;
+
+    /**
+     * @brief Iterator over the delimited records of a file
+     */
+    class SplitIterator;
+
+    /**
+     * @brief Iterator over the fixed-size binary records of a file
+     * @typeparam RecordType Type of the records
+     */
+    template <typename RecordType>
+    class RecordIterator;
+
+    /**
+     * @brief Wrapper for statically composed pipelines
+     * @typeparam Stage Type of the last stage
+     */
+    template <typename Stage>
+    class StaticWrapper;
+
+    /**
+     * @brief Wrapper for statically composed pipelines executed in parallel
+     * @typeparam Stage Type of the last stage
+     */
+    template <typename Stage>
+    class ParallelWrapper;
+
 } // namespace itertools
 
 #endif
@@ -24,10 +24,12 @@
 #define _ITERTOOLS_ZIP_HXX_
 
 #include "types.hxx"
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace itertools {
 
@@ -52,25 +54,119 @@ namespace itertools {
          */
         ZipIterator(std::shared_ptr<IIterator<FirstOutputType>> first,
                     std::shared_ptr<IIterator<SecondOutputType>> second)
-            : m_first(first), m_second(second) {}
+            : m_first(first), m_second(second), m_firstPosition(0) {}
 
         /**
          * @brief Returns the next element of zipped iterator.
          * @return Next element of zipped iterator.
          */
         Option<OutputPairType> next() override {
+            StageCounter::Scope scope = m_stats.next();
+            if (m_first && m_second && m_firstPosition < m_firstBatch.size()) {
+                Option<SecondOutputType> s = m_second->next();
+                if (s.isNone()) {
+                    return Option<OutputPairType>();
+                }
+                m_stats.pulled(1);
+                m_stats.yielded(1);
+                OutputPairType pair(std::forward<FirstOutputType>(m_firstBatch[m_firstPosition++]),
+                                    std::forward<SecondOutputType>(s.get()));
+                return Option<OutputPairType>(std::move(pair));
+            }
             while (m_first && m_second) {
                 Option<FirstOutputType> f = m_first->next();
                 Option<SecondOutputType> s = m_second->next();
                 if (f.isNone() || s.isNone()) {
                     return Option<OutputPairType>();
                 } else {
-                    return Option<OutputPairType>(std::make_pair(f.get(), s.get()));
+                    m_stats.pulled(1);
+                    m_stats.yielded(1);
+                    return Option<OutputPairType>(OutputPairType(std::forward<FirstOutputType>(f.get()),
+                                                                 std::forward<SecondOutputType>(s.get())));
                 }
             }
             return Option<OutputPairType>();
         }
 
+        /**
+         * @brief Append the next zipped elements to the given buffer
+         * @details Each iterator is pulled at most once per call, so elements only valid until the next pull of their
+         * source (e.g. views into a streamed file) stay valid. Elements of the first iterator left over because the
+         * second one yielded fewer are kept for the next call.
+         * @param buffer Buffer to append the elements to
+         * @param maxCount Maximum number of elements to append
+         * @return Number of appended elements, 0 only if the end is reached
+         */
+        size_t nextBatch(Batch<OutputPairType> &buffer, size_t maxCount) override {
+            StageCounter::Scope scope = m_stats.batch();
+            if (m_first && m_second && maxCount != 0) {
+                if (m_firstPosition == m_firstBatch.size()) {
+                    m_firstBatch.clear();
+                    m_firstPosition = 0;
+                    if (m_first->nextBatch(m_firstBatch, maxCount) == 0) {
+                        return 0;
+                    }
+                }
+                m_secondBatch.clear();
+                size_t count =
+                    m_second->nextBatch(m_secondBatch, std::min(maxCount, m_firstBatch.size() - m_firstPosition));
+                for (size_t i = 0; i < count; ++i) {
+                    buffer.emplace_back(std::forward<FirstOutputType>(m_firstBatch[m_firstPosition + i]),
+                                        std::forward<SecondOutputType>(m_secondBatch[i]));
+                }
+                m_firstPosition += count;
+                m_stats.pulled(count);
+                m_stats.yielded(count);
+                return count;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Skip the next elements of both iterators
+         * @param count Number of elements to skip
+         * @return Number of skipped elements, less than count only if the end is reached
+         */
+        size_t advanceBy(size_t count) override {
+            if (m_first && m_second) {
+                size_t buffered = std::min(count, m_firstBatch.size() - m_firstPosition);
+                m_firstPosition += buffered;
+                size_t skipped = m_second->advanceBy(buffered);
+                if (skipped < buffered || buffered == count) {
+                    return skipped;
+                }
+                return buffered +
+                       std::min(m_first->advanceBy(count - buffered), m_second->advanceBy(count - buffered));
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Get the bounds of the number of remaining elements
+         * @return Minimum of the bounds of both iterators
+         */
+        SizeHint sizeHint() const override {
+            if (m_first && m_second) {
+                size_t buffered = m_firstBatch.size() - m_firstPosition;
+                SizeHint first = m_first->sizeHint().transform([buffered](size_t n) { return n + buffered; });
+                return first.min(m_second->sizeHint());
+            }
+            return SizeHint::exact(0);
+        }
+
+        /**
+         * @brief Append the statistics of this iterator and its parents to a report
+         * @param report Report to append to
+         * @return Estimated time spent in this iterator including its parents
+         */
+        double collectStats(StatsReport &report) const override {
+            double parentSeconds = 0.0;
+            if (m_first && m_second) {
+                parentSeconds = m_first->collectStats(report) + m_second->collectStats(report);
+            }
+            return m_stats.report(report, "zip", parentSeconds);
+        }
+
         /**
          * @brief Zip iterator with another iterator
          * @typeparam OutputType Type of the other iterator
@@ -115,6 +211,14 @@ namespace itertools {
         std::shared_ptr<IIterator<FirstOutputType>> m_first;
         // Second iterator
         std::shared_ptr<IIterator<SecondOutputType>> m_second;
+        // Buffer of the last batch pulled from the first iterator
+        Batch<FirstOutputType> m_firstBatch;
+        // Position of the next element of the first batch not yet zipped
+        size_t m_firstPosition;
+        // Buffer of the last batch pulled from the second iterator
+        Batch<SecondOutputType> m_secondBatch;
+        // Statistics of the iterator
+        StageCounter m_stats;
     };
 
 } // namespace itertools
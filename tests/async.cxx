@@ -0,0 +1,88 @@
+#include "itertools.hxx"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<long> v1(100000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<long>(i);
+    }
+
+    // Test Case 1
+    // Hand over all elements of a chain running on its own thread.
+    auto iter1 = itertools::Iterator::from(v1).filter([](long &val) { return val % 2 == 0; }).async(2);
+    assert(iter1.sizeHint().upper().get() == v1.size());
+    auto result1 = iter1.map<long>([](long &val) { return val + 1; }).collectPush<std::vector<long>>();
+    assert(result1.size() == v1.size() / 2);
+    for (size_t i = 0; i < result1.size(); ++i) {
+        assert(result1[i] == static_cast<long>(2 * i + 1));
+    }
+
+    // Test Case 2
+    // Pull single elements of borrowed values and update the size hint.
+    auto iter2 = itertools::Iterator::borrow(v1).async();
+    assert(iter2.sizeHint().isExact());
+    assert(&iter2.inner()->next().get() == &v1[0]);
+    assert(&iter2.inner()->next().get() == &v1[1]);
+    assert(iter2.sizeHint().lower() == v1.size() - 2);
+    assert(iter2.sum().get() == static_cast<long>(v1.size() * (v1.size() - 1) / 2) - 1);
+
+    // Test Case 3
+    // Map on several workers and restore the order.
+    auto result3 = itertools::Iterator::from(v1)
+                       .asyncMap<std::string>([](long &val) { return std::to_string(val * 3); }, 4)
+                       .collectPush<std::vector<std::string>>();
+    assert(result3.size() == v1.size());
+    for (size_t i = 0; i < result3.size(); ++i) {
+        assert(result3[i] == std::to_string(i * 3));
+    }
+
+    // Test Case 4
+    // Map on several workers without keeping the order.
+    auto result4 = itertools::Iterator::from(v1)
+                       .asyncMap<long>([](long &val) { return val * 2; }, 3, false)
+                       .collectPush<std::vector<long>>();
+    assert(result4.size() == v1.size());
+    std::sort(result4.begin(), result4.end());
+    for (size_t i = 0; i < result4.size(); ++i) {
+        assert(result4[i] == static_cast<long>(2 * i));
+    }
+
+    // Test Case 5
+    // Rethrow exceptions of the workers on the consuming thread.
+    bool thrown5 = false;
+    try {
+        itertools::Iterator::from(v1)
+            .asyncMap<long>(
+                [](long &val) {
+                    if (val == 50000) {
+                        throw std::runtime_error("map failed");
+                    }
+                    return val;
+                },
+                2)
+            .collectPush<std::vector<long>>();
+    } catch (std::runtime_error const &e) {
+        thrown5 = std::string(e.what()) == "map failed";
+    }
+    assert(thrown5);
+
+    // Test Case 6
+    // Stop all threads if the iterator is destroyed before the end is reached.
+    {
+        auto iter6 = itertools::Iterator::from(v1).asyncMap<long>([](long &val) { return val; }, 2, true, 1);
+        assert(iter6.inner()->next().get() == 0);
+        assert(iter6.inner()->next().get() == 1);
+    }
+
+    // Test Case 7
+    // Iterate over an empty container.
+    std::vector<long> v7;
+    assert(itertools::Iterator::from(v7).async().sum().isNone());
+    assert(itertools::Iterator::from(v7).asyncMap<long>([](long &val) { return val; }, 2, false).sum().isNone());
+
+    // END
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "itertools.hxx"
+#include <list>
+#include <map>
+#include <vector>
+
+/**
+ * @brief Custom iterator only implementing next() to test the default batch implementation
+ */
+class CountIterator : public itertools::IIterator<int> {
+  public:
+    CountIterator(int count) : m_value(0), m_count(count) {}
+
+    itertools::Option<int> next() override {
+        if (m_value < m_count) {
+            return itertools::Option<int>(m_value++);
+        }
+        return itertools::Option<int>();
+    }
+
+  private:
+    int m_value;
+    int m_count;
+};
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1(5000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<int>(i);
+    }
+    std::list<int> l1(v1.begin(), v1.end());
+
+    // Test Case 1
+    // Pull batches from a basic iterator over a random access and a bidirectional container.
+    auto iter1 = itertools::Iterator::from(v1).inner();
+    auto iter2 = itertools::Iterator::from(l1).inner();
+    std::vector<int> batch1;
+    std::vector<int> batch2;
+    assert(iter1->nextBatch(batch1, 3000) == 3000U);
+    assert(iter2->nextBatch(batch2, 3000) == 3000U);
+    assert(iter1->nextBatch(batch1, 3000) == 2000U);
+    assert(iter2->nextBatch(batch2, 3000) == 2000U);
+    assert(iter1->nextBatch(batch1, 3000) == 0U);
+    assert(iter2->nextBatch(batch2, 3000) == 0U);
+    assert(batch1 == v1);
+    assert(batch2 == v1);
+
+    // Test Case 2
+    // Pull a slice from a basic iterator without copying the elements.
+    auto slice = itertools::Iterator::from(v1).inner()->nextSlice(10);
+    assert(&*slice.first == v1.data());
+    assert(slice.second - slice.first == 10);
+
+    // Test Case 3
+    // Drain a filtered, mapped and enumerated iterator in batches.
+    auto result3 = itertools::Iterator::from(v1)
+                       .filter([](int &val) { return val % 3 == 0; })
+                       .map<long>([](int &val) { return static_cast<long>(val) * 2; })
+                       .enumerate()
+                       .collectPush<std::vector<std::pair<size_t, long>>>();
+
+    assert(result3.size() == 1667U);
+    for (size_t i = 0; i < result3.size(); ++i) {
+        assert(result3[i].first == i);
+        assert(result3[i].second == static_cast<long>(i) * 6);
+    }
+
+    // Test Case 4
+    // Zip iterators of different lengths in batches.
+    std::vector<int> v2 = {1, 2, 3};
+    auto result4 = itertools::Iterator::from(v1)
+                       .filter([](int &val) { return val % 2 == 1; })
+                       .zip<int>(itertools::Iterator::from(v2).into())
+                       .collectInsert<std::map<int, int>>();
+
+    assert(result4.size() == 3U);
+    assert(result4[1] == 1);
+    assert(result4[3] == 2);
+    assert(result4[5] == 3);
+
+    // Test Case 5
+    // Use the default batch implementation of a custom iterator.
+    auto iter5 = itertools::IteratorWrapper<itertools::IIterator<int>, int>(std::make_shared<CountIterator>(3000));
+    itertools::Option<int> sum = iter5.sum();
+    assert(sum.isSome());
+    assert(sum.get() == 2999 * 3000 / 2);
+    assert(iter5.sum().isNone());
+
+    // END
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "itertools.hxx"
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Value type counting its copies and lacking a default constructor
+ */
+class Record {
+  public:
+    Record(int value) : m_value(value) {}
+    Record(Record const &other) : m_value(other.m_value) { ++copies; }
+    Record(Record &&other) = default;
+    Record &operator=(Record const &other) {
+        m_value = other.m_value;
+        ++copies;
+        return *this;
+    }
+    Record &operator=(Record &&other) = default;
+
+    int value() const { return m_value; }
+
+    static size_t copies;
+
+  private:
+    int m_value;
+};
+
+size_t Record::copies = 0;
+
+int main(int argc, char *argv[]) {
+    std::vector<Record> v1;
+    for (int i = 0; i < 2000; ++i) {
+        v1.emplace_back(i);
+    }
+
+    // Test Case 1
+    // Store values without default constructor in an Option and move them out again.
+    itertools::Option<Record> opt1;
+    assert(opt1.isNone());
+    opt1 = itertools::Option<Record>(Record(42));
+    assert(opt1.isSome());
+    itertools::Option<Record> opt2(std::move(opt1));
+    assert(opt2.get().value() == 42);
+    Record record = opt2.take();
+    assert(opt2.isNone());
+    assert(record.value() == 42);
+    assert(Record::copies == 0U);
+
+    // Test Case 2
+    // Reference a value by an Option.
+    int value = 5;
+    itertools::Option<int &> opt3(value);
+    opt3.get() = 6;
+    assert(value == 6);
+    assert(&opt3.take() == &value);
+    assert(opt3.isNone());
+
+    // Test Case 3
+    // Borrow the elements of a container, enumerate and filter them without copying.
+    auto result3 = itertools::Iterator::borrow(v1)
+                       .enumerate()
+                       .filter([](std::pair<size_t, Record &> &val) { return val.second.value() % 2 == 0; })
+                       .map<Record const *>([](std::pair<size_t, Record &> &val) { return &val.second; })
+                       .collectPush<std::vector<Record const *>>();
+
+    assert(Record::copies == 0U);
+    assert(result3.size() == v1.size() / 2);
+    for (size_t i = 0; i < result3.size(); ++i) {
+        assert(result3[i] == &v1[2 * i]);
+    }
+
+    // Test Case 4
+    // Borrow the elements of two containers and zip them without copying.
+    std::vector<Record> v2(v1.rbegin(), v1.rend());
+    Record::copies = 0;
+    auto result4 = itertools::Iterator::borrow(v1)
+                       .zip<Record &>(itertools::Iterator::borrow(v2).into())
+                       .map<int>([](std::pair<Record &, Record &> &val) {
+                           return val.first.value() + val.second.value();
+                       })
+                       .max();
+
+    assert(Record::copies == 0U);
+    assert(result4.isSome());
+    assert(result4.get() == 1999);
+
+    // Test Case 5
+    // Consume a container and move its elements through the pipeline into the collection.
+    std::vector<Record> v5(v1.begin(), v1.begin() + 100);
+    Record::copies = 0;
+    auto result5 = itertools::Iterator::from(std::move(v5))
+                       .enumerate()
+                       .filter([](std::pair<size_t, Record> &val) { return val.first % 10 == 0; })
+                       .collectPush<std::vector<std::pair<size_t, Record>>>();
+
+    assert(Record::copies == 0U);
+    assert(result5.size() == 10U);
+    for (size_t i = 0; i < result5.size(); ++i) {
+        assert(result5[i].second.value() == static_cast<int>(10 * i));
+    }
+
+    // Test Case 6
+    // Collect borrowed strings into a container of copies.
+    std::vector<std::string> v6 = {"a", "b", "c"};
+    auto result6 = itertools::Iterator::borrow(v6).collectPush<std::vector<std::string>>();
+    assert(result6 == v6);
+
+    // Test Case 7
+    // Move Options instead of copying them when their buffer grows.
+    static_assert(std::is_nothrow_move_constructible_v<itertools::Option<Record>>);
+    static_assert(std::is_nothrow_move_assignable_v<itertools::Option<Record>>);
+    Record::copies = 0;
+    std::vector<itertools::Option<Record>> options7;
+    for (int i = 0; i < 1000; ++i) {
+        options7.emplace_back(Record(i));
+    }
+    assert(options7[999].get().value() == 999);
+    assert(Record::copies == 0U);
+
+    // END
+    return 0;
+}
@@ -0,0 +1,10 @@
+#include "itertools.hxx"
+
+int main(int argc, char *argv[]) {
+    // Test Case 1
+    // Chunking views of file records doesn't compile, as they may dangle after the next pull.
+    auto chunks1 = itertools::Iterator::lines("/dev/null").chunks(4);
+
+    // END
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "itertools.hxx"
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Fixed-size binary record
+ */
+struct Record {
+    int id;
+    double value;
+};
+
+/**
+ * @brief Write the given bytes to a file
+ */
+void writeFile(std::string const &path, void const *data, size_t size) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    assert(fd >= 0);
+    assert(::write(fd, data, size) == static_cast<ssize_t>(size));
+    ::close(fd);
+}
+
+/**
+ * @brief Read all bytes of a file
+ */
+std::string readFile(std::string const &path) {
+    std::string content;
+    char buffer[4096];
+    int fd = ::open(path.c_str(), O_RDONLY);
+    assert(fd >= 0);
+    ssize_t count;
+    while ((count = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        content.append(buffer, static_cast<size_t>(count));
+    }
+    ::close(fd);
+    return content;
+}
+
+int main(int argc, char *argv[]) {
+    std::string dir = "/tmp/itertools-cxx-file-" + std::to_string(::getpid());
+    assert(::mkdir(dir.c_str(), 0700) == 0);
+
+    std::string text;
+    for (int i = 0; i < 20000; ++i) {
+        text += "line " + std::to_string(i) + "\n";
+    }
+    text += "last";
+    writeFile(dir + "/lines.txt", text.data(), text.size());
+
+    // Test Case 1
+    // Iterate over the lines of a mapped file. The views are valid as long as the iterator exists.
+    auto lines1 = itertools::Iterator::lines(dir + "/lines.txt");
+    auto result1 = lines1.filter([](std::string_view &line) { return line.size() == 7; })
+                       .collectPush<std::vector<std::string_view>>();
+
+    assert(result1.size() == 90U);
+    assert(result1[0] == "line 10");
+    assert(result1[89] == "line 99");
+
+    auto count1 =
+        itertools::Iterator::lines(dir + "/lines.txt").map<size_t>([](std::string_view &) { return 1; }).sum();
+    assert(count1.get() == 20001U);
+
+    // Test Case 2
+    // Split a file by a custom delimiter.
+    std::string csv = "a,bb,,ccc,";
+    writeFile(dir + "/values.csv", csv.data(), csv.size());
+    auto result2 = itertools::Iterator::split(dir + "/values.csv", ',')
+                       .map<std::string>([](std::string_view &value) { return std::string(value); })
+                       .collectPush<std::vector<std::string>>();
+    assert((result2 == std::vector<std::string>{"a", "bb", "", "ccc"}));
+
+    // Test Case 3
+    // Iterate over the fixed-size records of a mapped file.
+    std::vector<Record> records;
+    for (int i = 0; i < 5000; ++i) {
+        records.push_back(Record{i, i * 0.5});
+    }
+    writeFile(dir + "/records.bin", records.data(), records.size() * sizeof(Record));
+
+    auto iter3 = itertools::Iterator::records<Record>(dir + "/records.bin");
+    assert(iter3.sizeHint().isExact());
+    assert(iter3.sizeHint().lower() == records.size());
+    auto sum3 = iter3.map<double>([](Record const &record) { return record.value; }).sum();
+    assert(sum3.get() == 4999.0 * 5000.0 / 4.0);
+
+    // Test Case 4
+    // Read lines and records from a pipe using the buffered fallback.
+    std::string fifo = dir + "/fifo";
+    assert(::mkfifo(fifo.c_str(), 0600) == 0);
+    std::thread writer4([&fifo, &text]() { writeFile(fifo, text.data(), text.size()); });
+    auto result4 = itertools::Iterator::lines(fifo)
+                       .map<std::string>([](std::string_view &line) { return std::string(line); })
+                       .collectPush<std::vector<std::string>>();
+    writer4.join();
+
+    assert(result4.size() == 20001U);
+    for (size_t i = 0; i < 20000; ++i) {
+        assert(result4[i] == "line " + std::to_string(i));
+    }
+    assert(result4[20000] == "last");
+
+    std::thread writer5([&fifo, &records]() { writeFile(fifo, records.data(), records.size() * sizeof(Record)); });
+    auto result5 = itertools::Iterator::records<Record>(fifo)
+                       .enumerate()
+                       .filter([](std::pair<size_t, Record const &> &val) {
+                           return val.second.id == static_cast<int>(val.first);
+                       })
+                       .map<int>([](std::pair<size_t, Record const &> &val) { return val.second.id; })
+                       .collectPush<std::vector<int>>();
+    writer5.join();
+
+    assert(result5.size() == records.size());
+
+    // Test Case 6
+    // Write the elements of a pipeline to a file descriptor.
+    std::vector<int> v6 = {1, 2, 3, 4, 5, 6};
+    int fd = ::open((dir + "/output.txt").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    assert(fd >= 0);
+    size_t count6 = itertools::Iterator::from(v6).filter([](int &val) { return val % 2 == 0; }).writeTo(fd);
+    size_t count7 = itertools::Iterator::split(dir + "/values.csv", ',').writeTo(fd, ';');
+    ::close(fd);
+
+    assert(count6 == 3U);
+    assert(count7 == 4U);
+    assert(readFile(dir + "/output.txt") == "2\n4\n6\na;bb;;ccc;");
+
+    // Test Case 7
+    // Zip streamed lines with another source. The lines are pulled once per batch, so the views stay valid.
+    std::vector<size_t> v7(30000);
+    for (size_t i = 0; i < v7.size(); ++i) {
+        v7[i] = i;
+    }
+    std::thread writer7([&fifo, &text]() { writeFile(fifo, text.data(), text.size()); });
+    auto iter7 = itertools::Iterator::from(v7).zip<std::string_view>(itertools::Iterator::lines(fifo).into());
+    auto first7 = iter7.inner()->next();
+    assert(!first7.isNone() && first7.get().second == "line 0");
+    auto mismatches7 = iter7
+                           .map<size_t>([](std::pair<size_t, std::string_view> &val) -> size_t {
+                               return val.first < 20000 ? val.second != "line " + std::to_string(val.first)
+                                                        : val.second != "last";
+                           })
+                           .sum();
+    writer7.join();
+
+    assert(mismatches7.get() == 0U);
+
+    // Test Case 8
+    // Reduce streamed lines, the accumulator owns its value across pulls.
+    std::thread writer8([&fifo, &text]() { writeFile(fifo, text.data(), text.size()); });
+    auto min8 = itertools::Iterator::lines(fifo).min();
+    writer8.join();
+    std::thread writer9([&fifo, &text]() { writeFile(fifo, text.data(), text.size()); });
+    auto max8 = itertools::Iterator::lines(fifo).max();
+    writer9.join();
+
+    assert(min8.get() == "last");
+    assert(max8.get() == "line 9999");
+
+    // Clean up
+    for (std::string name : {"lines.txt", "values.csv", "records.bin", "fifo", "output.txt"}) {
+        ::unlink((dir + "/" + name).c_str());
+    }
+    ::rmdir(dir.c_str());
+
+    // END
+    return 0;
+}
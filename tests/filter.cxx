@@ -56,6 +56,26 @@ int main(int argc, char *argv[]) {
     assert(result4[0] == 0x43);
     assert(result4[1] == 0x45);
 
+    // Test Case 5
+    // Keep changes of the filter to arithmetic values when pulling in batches and one by one.
+    auto scale5 = [](int &val) {
+        bool even = val % 2 == 0;
+        val *= 0x10;
+        return even;
+    };
+    auto result5 = itertools::Iterator::from(v1)
+                       .map<int>([](int &val) { return val; })
+                       .filter(scale5)
+                       .collectPush<std::vector<int>>();
+    auto iter5 = itertools::Iterator::from(v1).map<int>([](int &val) { return val; }).filter(scale5);
+    std::vector<int> next5;
+    for (auto opt = iter5.inner()->next(); opt.isSome(); opt = iter5.inner()->next()) {
+        next5.push_back(opt.get());
+    }
+
+    assert((result5 == std::vector<int>{0x420, 0x440, 0x460}));
+    assert(result5 == next5);
+
     // END
     return 0;
 }
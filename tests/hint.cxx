@@ -0,0 +1,67 @@
+#include "itertools.hxx"
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1(1000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<int>(i);
+    }
+    std::vector<char> v2(300, 'A');
+    std::list<int> l1(v1.begin(), v1.end());
+
+    // Test Case 1
+    // Get the exact size hint of a basic iterator and pass it through map and enumerate.
+    auto iter1 = itertools::Iterator::from(v1);
+    assert(iter1.sizeHint().isExact());
+    assert(iter1.sizeHint().lower() == 1000U);
+    iter1.inner()->next();
+    assert(iter1.sizeHint().lower() == 999U);
+
+    auto hint1 = itertools::Iterator::from(v1).map<long>([](int &val) { return val; }).enumerate().sizeHint();
+    assert(hint1.isExact());
+    assert(hint1.lower() == 1000U);
+
+    // Test Case 2
+    // Get the size hints of filtered and zipped iterators.
+    auto hint2 = itertools::Iterator::from(v1).filter([](int &val) { return val % 2 == 0; }).sizeHint();
+    assert(!hint2.isExact());
+    assert(hint2.lower() == 0U);
+    assert(hint2.upper().get() == 1000U);
+
+    auto hint3 = itertools::Iterator::from(v1).zip<char>(itertools::Iterator::from(v2).into()).sizeHint();
+    assert(hint3.isExact());
+    assert(hint3.lower() == 300U);
+
+    auto hint4 = itertools::Iterator::from(l1).zip<char>(itertools::Iterator::from(v2).into()).sizeHint();
+    assert(hint4.lower() == 0U);
+    assert(hint4.upper().get() == 300U);
+
+    // Test Case 3
+    // Collect into containers reserved by the exact size hint.
+    auto result3 = itertools::Iterator::from(v1)
+                       .map<long>([](int &val) { return val * 2; })
+                       .collectPush<std::vector<long>>();
+    assert(result3.size() == v1.size());
+    assert(result3.capacity() == v1.size());
+
+    auto result4 = itertools::Iterator::from(v2).collectPush<std::string>();
+    assert(result4 == std::string(300, 'A'));
+    assert(result4.capacity() == 300U);
+
+    auto result5 = itertools::Iterator::from(v1).enumerate().collectInsert<std::unordered_map<size_t, int>>();
+    assert(result5.size() == v1.size());
+    assert(result5.bucket_count() * result5.max_load_factor() >= v1.size());
+
+    // Test Case 4
+    // Collect a static pipeline into a container reserved by the exact size hint.
+    auto result6 = itertools::Iterator::fuse(v1).map([](int &val) { return val + 1; }).collectPush<std::vector<int>>();
+    assert(result6.size() == v1.size());
+    assert(result6.capacity() == v1.size());
+    assert(itertools::Iterator::fuse(v1).filter([](int &val) { return val > 5; }).sizeHint().lower() == 0U);
+
+    // END
+    return 0;
+}
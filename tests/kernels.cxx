@@ -0,0 +1,110 @@
+#include "itertools.hxx"
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1(1000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<int>((i * 7919) % 1000) - 500;
+    }
+
+    // Test Case 1
+    // Calculate sum, min and max of a contiguous integer source and compare with a sequential fold.
+    int sum = 0;
+    int min = v1[0];
+    int max = v1[0];
+    for (int val : v1) {
+        sum += val;
+        min = val < min ? val : min;
+        max = max < val ? val : max;
+    }
+    assert(itertools::Iterator::from(v1).sum().get() == sum);
+    assert(itertools::Iterator::from(v1).min().get() == min);
+    assert(itertools::Iterator::from(v1).max().get() == max);
+
+    // Test Case 2
+    // Calculate the wrapping product of a contiguous unsigned source and compare with a sequential fold.
+    std::vector<uint8_t> v2(100);
+    uint8_t product = 1;
+    for (size_t i = 0; i < v2.size(); ++i) {
+        v2[i] = static_cast<uint8_t>(i * 2 + 1);
+        product = static_cast<uint8_t>(product * v2[i]);
+    }
+    assert(itertools::Iterator::from(v2).product().get() == product);
+
+    // Test Case 3
+    // Calculate the sum of a contiguous floating point source in sequential order.
+    std::vector<float> v3(1000);
+    float fsum = 0.0f;
+    for (size_t i = 0; i < v3.size(); ++i) {
+        v3[i] = 1.0f / static_cast<float>(i + 1);
+        fsum += v3[i];
+    }
+    assert(itertools::Iterator::from(v3).sum().get() == fsum);
+
+    // Test Case 4
+    // Reduce an empty contiguous source and a non-contiguous chain.
+    std::vector<int> v4;
+    assert(itertools::Iterator::from(v4).sum().isNone());
+    assert(itertools::Iterator::from(v4).min().isNone());
+    auto max4 = itertools::Iterator::from(v1).map<int>([](int &val) { return -val; }).max();
+    assert(max4.isSome());
+    assert(max4.get() == -min);
+
+    // Test Case 5
+    // Compact a contiguous integer source with a filter.
+    auto result5 = itertools::Iterator::from(v1)
+                       .filter([](int &val) { return val > 250; })
+                       .collectPush<std::vector<int>>();
+
+    size_t index = 0;
+    for (int val : v1) {
+        if (val > 250) {
+            assert(result5[index++] == val);
+        }
+    }
+    assert(result5.size() == index);
+
+    // Test Case 6
+    // Calculate the wrapping product and sum of contiguous 16 bit sources without signed overflow.
+    std::vector<uint16_t> v6(1000);
+    uint32_t uproduct6 = 1;
+    uint32_t usum6 = 0;
+    for (size_t i = 0; i < v6.size(); ++i) {
+        v6[i] = static_cast<uint16_t>(65535 - 2 * i);
+        uproduct6 = (uproduct6 * v6[i]) & 0xffffU;
+        usum6 = (usum6 + v6[i]) & 0xffffU;
+    }
+    assert(itertools::Iterator::from(v6).product().get() == static_cast<uint16_t>(uproduct6));
+    assert(itertools::Iterator::from(v6).sum().get() == static_cast<uint16_t>(usum6));
+
+    std::vector<int16_t> s6(1000);
+    uint32_t sproduct6 = 1;
+    uint32_t ssum6 = 0;
+    for (size_t i = 0; i < s6.size(); ++i) {
+        s6[i] = static_cast<int16_t>(i % 2 == 0 ? 32767 - static_cast<int>(i) : -32768 + static_cast<int>(i));
+        sproduct6 = (sproduct6 * static_cast<uint16_t>(s6[i])) & 0xffffU;
+        ssum6 = (ssum6 + static_cast<uint16_t>(s6[i])) & 0xffffU;
+    }
+    assert(itertools::Iterator::from(s6).product().get() == static_cast<int16_t>(sproduct6));
+    assert(itertools::Iterator::from(s6).sum().get() == static_cast<int16_t>(ssum6));
+
+    // Test Case 7
+    // Compact ranges where no value, every value or only the last value passes.
+    std::vector<int> v7 = {1, 2, 3, 4, 5};
+    std::vector<int> out7(v7.size());
+    auto none7 = [](int &) { return false; };
+    auto all7 = [](int &) { return true; };
+    auto last7 = [](int &val) { return val == 5; };
+    assert(itertools::kernels::compact(v7.data(), 0, out7.data(), all7) == 0U);
+    assert(itertools::kernels::compact(v7.data(), v7.size(), out7.data(), none7) == 0U);
+    assert(itertools::kernels::compact(v7.data(), v7.size(), out7.data(), all7) == 5U);
+    assert(out7 == v7);
+    assert(itertools::kernels::compact(v7.data(), v7.size(), out7.data(), last7) == 1U);
+    assert(out7[0] == 5);
+    assert(itertools::Iterator::from(v7).filter(none7).collectPush<std::vector<int>>().empty());
+
+    // END
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "itertools.hxx"
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Memory resource counting the allocations forwarded to its upstream resource
+ */
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    CountingResource() : allocations(0) {}
+
+    size_t allocations;
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const &other) const noexcept override { return this == &other; }
+};
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1 = {0x41, 0x42, 0x43, 0x44, 0x45, 0x46};
+    std::vector<char> v2 = {'a', 'b', 'c', 'd', 'e', 'f', 'g'};
+
+    // Test Case 1
+    // Place all nodes of a five stage chain in a single monotonic buffer.
+    CountingResource upstream;
+    std::pmr::monotonic_buffer_resource arena(4096, &upstream);
+    auto iter1 = itertools::Iterator::from(v1, &arena)
+                     .map<int>([](int &val) { return val * 2; })
+                     .filter([](int &val) { return val % 4 == 0; })
+                     .zip<char>(itertools::Iterator::from(v2).into())
+                     .enumerate();
+    assert(upstream.allocations == 1U);
+
+    auto result1 = iter1.collectPush<std::vector<std::pair<size_t, std::pair<int, char>>>>();
+    assert(result1.size() == 3U);
+    for (size_t i = 0; i < result1.size(); ++i) {
+        assert(result1[i].first == i);
+        assert(result1[i].second.first == v1[2 * i + 1] * 2);
+        assert(result1[i].second.second == v2[i]);
+    }
+
+    // Test Case 2
+    // Collect into a pmr container allocated from the same memory resource.
+    CountingResource resource;
+    auto result2 = itertools::Iterator::from(v1, &resource)
+                       .map<std::pmr::string>([](int &val) { return std::pmr::string(20, static_cast<char>(val)); })
+                       .collectPush<std::pmr::vector<std::pmr::string>>();
+
+    assert(result2.get_allocator().resource() == &resource);
+    assert(result2.size() == v1.size());
+    assert(result2[0] == std::pmr::string(20, 'A'));
+
+    // Test Case 3
+    // Collect into a pmr container without memory resource.
+    auto result3 = itertools::Iterator::from(v1).collectPush<std::pmr::vector<int>>();
+    assert(result3.get_allocator().resource() == std::pmr::get_default_resource());
+    assert(result3.size() == v1.size());
+
+    // END
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "itertools.hxx"
+#include <list>
+#include <set>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<long> v1(100000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<long>(i);
+    }
+    itertools::ThreadPool pool(4);
+
+    // Test Case 1
+    // Calculate the sum of a mapped and filtered pipeline in parallel.
+    auto sum1 = itertools::Iterator::fuse(v1)
+                    .map([](long &val) { return val * 2; })
+                    .filter([](long &val) { return val % 3 == 0; })
+                    .par(pool)
+                    .sum();
+
+    long expected1 = 0;
+    for (long val : v1) {
+        if ((val * 2) % 3 == 0) {
+            expected1 += val * 2;
+        }
+    }
+    assert(sum1.isSome());
+    assert(sum1.get() == expected1);
+
+    // Test Case 2
+    // Collect an enumerated pipeline in parallel and check order and global indices.
+    auto result2 = itertools::Iterator::fuse(v1)
+                       .map([](long &val) { return val + 1; })
+                       .enumerate()
+                       .filter([](std::pair<size_t, long> &val) { return val.second % 7 == 0; })
+                       .par(pool)
+                       .collectPush<std::vector<std::pair<size_t, long>>>();
+
+    assert(result2.size() == v1.size() / 7);
+    for (size_t i = 0; i < result2.size(); ++i) {
+        assert(result2[i].first == 7 * i + 6);
+        assert(result2[i].second == static_cast<long>(7 * i + 7));
+    }
+
+    // Test Case 3
+    // Collect a zipped pipeline in parallel into a set.
+    std::vector<long> v3(v1.rbegin(), v1.rend());
+    auto result3 = itertools::Iterator::fuse(v1)
+                       .zip(itertools::Iterator::fuse(v3))
+                       .map([](std::pair<long, long> &val) { return val.first + val.second; })
+                       .par(pool)
+                       .collectInsert<std::set<long>>();
+
+    assert(result3.size() == 1U);
+    assert(*result3.begin() == static_cast<long>(v1.size()) - 1);
+
+    // Test Case 4
+    // Fall back to sequential execution for pipelines that can't be split.
+    std::list<long> l4(v1.begin(), v1.begin() + 10);
+    auto product4 = itertools::Iterator::fuse(l4).map([](long &val) { return val + 1; }).par(pool).product();
+    assert(product4.isSome());
+    assert(product4.get() == 3628800);
+
+    auto result4 = itertools::Iterator::fuse(v1)
+                       .filter([](long &val) { return val % 2 == 0; })
+                       .enumerate()
+                       .par(pool)
+                       .collectPush<std::vector<std::pair<size_t, long>>>();
+
+    assert(result4.size() == v1.size() / 2);
+    for (size_t i = 0; i < result4.size(); ++i) {
+        assert(result4[i].first == i);
+        assert(result4[i].second == static_cast<long>(2 * i));
+    }
+
+    // Test Case 5
+    // Reduce an empty pipeline in parallel on the global thread pool.
+    std::vector<long> v5;
+    assert(itertools::Iterator::fuse(v5).par().sum().isNone());
+
+    // END
+    return 0;
+}
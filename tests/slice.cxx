@@ -0,0 +1,101 @@
+#include "itertools.hxx"
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1(1000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<int>(i);
+    }
+    std::list<int> l1(v1.begin(), v1.end());
+    size_t calls = 0;
+    std::function<long(int &)> counted = [&calls](int &val) {
+        ++calls;
+        return val * 2L;
+    };
+
+    // Test Case 1
+    // Skip and take a page without mapping the skipped elements.
+    auto page1 = itertools::Iterator::from(v1).map<long>(counted).skip(500).take(10).collectPush<std::vector<long>>();
+    assert(page1.size() == 10U);
+    for (size_t i = 0; i < page1.size(); ++i) {
+        assert(page1[i] == static_cast<long>(2 * (500 + i)));
+    }
+    assert(calls == 10U);
+
+    auto hint1 = itertools::Iterator::from(v1).skip(990).sizeHint();
+    assert(hint1.isExact());
+    assert(hint1.lower() == 10U);
+    assert(itertools::Iterator::from(v1).skip(2000).collectPush<std::vector<int>>().empty());
+    assert(itertools::Iterator::from(v1).take(2000).sizeHint().lower() == 1000U);
+    assert(itertools::Iterator::from(v1).take(5).sizeHint().lower() == 5U);
+
+    // Test Case 2
+    // Get the n-th element and adjust the index of enumerated iterators.
+    calls = 0;
+    auto iter2 = itertools::Iterator::from(v1).map<long>(counted).enumerate();
+    auto nth2 = iter2.nth(700);
+    assert(nth2.isSome());
+    assert(nth2.get().first == 700U);
+    assert(nth2.get().second == 1400L);
+    assert(iter2.inner()->next().get().first == 701U);
+    assert(calls == 2U);
+    assert(iter2.nth(1000).isNone());
+
+    auto zipped2 = itertools::Iterator::from(v1).zip<int>(itertools::Iterator::from(l1).into()).nth(42);
+    assert(zipped2.get().first == 42);
+    assert(zipped2.get().second == 42);
+    assert(itertools::Iterator::from(l1).nth(999).get() == 999);
+    assert(itertools::Iterator::from(l1).nth(1000).isNone());
+
+    // Test Case 3
+    // Sample every n-th element.
+    calls = 0;
+    auto iter3 = itertools::Iterator::from(v1).map<long>(counted).stepBy(100);
+    assert(iter3.sizeHint().lower() == 10U);
+    auto sample3 = iter3.collectPush<std::vector<long>>();
+    assert(sample3.size() == 10U);
+    for (size_t i = 0; i < sample3.size(); ++i) {
+        assert(sample3[i] == static_cast<long>(200 * i));
+    }
+    assert(calls == 10U);
+    assert(itertools::Iterator::from(v1).stepBy(3).collectPush<std::vector<int>>().size() == 334U);
+
+    // Test Case 4
+    // Split the elements into chunks and skip chunks.
+    auto iter4 = itertools::Iterator::from(v1).chunks(300);
+    assert(iter4.sizeHint().lower() == 4U);
+    auto chunks4 = iter4.collectPush<std::vector<std::vector<int>>>();
+    assert(chunks4.size() == 4U);
+    assert(chunks4[0].size() == 300U);
+    assert(chunks4[3].size() == 100U);
+    assert(chunks4[3][0] == 900);
+
+    auto chunk4 = itertools::Iterator::from(l1).filter([](int &val) { return val % 2 == 0; }).chunks(7).nth(2);
+    assert(chunk4.get().size() == 7U);
+    assert(chunk4.get()[0] == 28);
+
+    // Test Case 5
+    // Chunk borrowed elements without copying them.
+    auto chunk5 = itertools::Iterator::borrow(v1).skip(10).chunks(4).nth(0);
+    assert(chunk5.get().size() == 4U);
+    assert(&chunk5.get()[0].get() == &v1[10]);
+
+    // Test Case 6
+    // Skip more elements than fit into size_t without wrapping around.
+    size_t max6 = std::numeric_limits<size_t>::max();
+    auto iter6 = itertools::Iterator::from(v1).skip(5);
+    assert(iter6.inner()->advanceBy(max6) == 995U);
+    assert(iter6.inner()->next().isNone());
+    assert(itertools::Iterator::from(v1).skip(5).nth(max6).isNone());
+
+    auto chunks6 = itertools::Iterator::from(v1).chunks(300);
+    assert(chunks6.inner()->advanceBy(max6 / 300 + 1) == 4U);
+    assert(chunks6.inner()->next().isNone());
+    assert(itertools::Iterator::from(v1).chunks(7).nth(max6 / 2).isNone());
+
+    // END
+    return 0;
+}
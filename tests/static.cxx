@@ -0,0 +1,76 @@
+#include "itertools.hxx"
+#include <map>
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1 = {0x41, 0x42, 0x43, 0x44, 0x45, 0x46};
+    std::vector<char> v2 = {'A', 'B', 'C', 'D', 'E', 'F', 'G'};
+    std::vector<char> v3 = {'A', 'X', 'C', 'X', 'E', 'X', 'G'};
+
+    // Test Case 1
+    // Create a fused pipeline, filter even numbers, map to char and collect them.
+    auto result1 = itertools::Iterator::fuse(v1)
+                       .filter([](int &val) { return val % 2 == 0; })
+                       .map<char>([](int &val) { return static_cast<char>(val); })
+                       .collectPush<std::vector<char>>();
+
+    assert(result1.size() == 3U);
+    for (size_t i = 0; i < result1.size(); ++i) {
+        assert(result1[i] == v2[2 * i + 1]);
+    }
+
+    // Test Case 2
+    // Create a fused pipeline with deduced map type and collect it in a map.
+    auto result2 = itertools::Iterator::fuse(v1)
+                       .map([](int &val) { return std::make_pair(val, val * 2); })
+                       .collectInsert<std::map<int, int>>();
+
+    assert(result2.size() == v1.size());
+    for (auto iter = result2.begin(); iter != result2.end(); ++iter) {
+        assert((*iter).second == (*iter).first * 2);
+    }
+
+    // Test Case 3
+    // Create a fused pipeline, enumerate it and zip it with another fused pipeline.
+    auto result3 = itertools::Iterator::fuse(v2)
+                       .enumerate()
+                       .zip(itertools::Iterator::fuse(v3))
+                       .filter([](std::pair<std::pair<size_t, char>, char> &val) {
+                           return val.first.second == val.second;
+                       })
+                       .collectPush<std::vector<std::pair<std::pair<size_t, char>, char>>>();
+
+    assert(result3.size() == 4U);
+    for (size_t i = 0; i < result3.size(); ++i) {
+        assert(result3[i].first.first == 2 * i);
+        assert(result3[i].first.second == v3[2 * i]);
+    }
+
+    // Test Case 4
+    // Calculate the sum and product of fused pipelines.
+    itertools::Option<int> sum = itertools::Iterator::fuse(v1).map([](int &val) { return val - 0x40; }).sum();
+    assert(sum.isSome());
+    assert(sum.get() == 1 + 2 + 3 + 4 + 5 + 6);
+
+    itertools::Option<int> product = itertools::Iterator::fuse(v1).map([](int &val) { return val - 0x40; }).product();
+    assert(product.isSome());
+    assert(product.get() == 1 * 2 * 3 * 4 * 5 * 6);
+
+    // Test Case 5
+    // Transform a fused pipeline into the type-erased iterator and zip it with a dynamic iterator.
+    auto result5 = itertools::Iterator::from(v1)
+                       .zip<std::string>(itertools::Iterator::fuse(v2)
+                                             .map<std::string>([](char &val) { return std::string(1, val); })
+                                             .into())
+                       .collectPush<std::vector<std::pair<int, std::string>>>();
+
+    assert(result5.size() == v1.size());
+    for (size_t i = 0; i < result5.size(); ++i) {
+        assert(result5[i].first == v1[i]);
+        assert(result5[i].second == std::string(1, v2[i]));
+    }
+
+    // END
+    return 0;
+}
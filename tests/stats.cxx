@@ -0,0 +1,100 @@
+#define ITERTOOLS_STATS
+#include "itertools.hxx"
+#include <string>
+#include <vector>
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1(1000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<int>(i);
+    }
+    std::vector<char> v2(300, 'A');
+
+    // Test Case 1
+    // Count the elements of each stage when pulling one by one.
+    auto iter1 = itertools::Iterator::from(v1).filter([](int &val) { return val % 4 == 0; }).map<long>([](int &val) {
+        return val * 2L;
+    });
+    size_t count1 = 0;
+    while (iter1.inner()->next().isSome()) {
+        ++count1;
+    }
+    assert(count1 == 250U);
+    auto stages1 = iter1.stats().stages();
+    assert(stages1.size() == 3U);
+    assert(stages1[0].name == "basic");
+    assert(stages1[0].yielded == 1000U);
+    assert(stages1[1].name == "filter");
+    assert(stages1[1].pulled == 1000U);
+    assert(stages1[1].yielded == 250U);
+    assert(stages1[1].selectivity() == 0.25);
+    assert(stages1[2].name == "map");
+    assert(stages1[2].nextCalls == 251U);
+    assert(stages1[2].yielded == 250U);
+    assert(stages1[2].batchCalls == 0U);
+    assert(stages1[2].seconds >= stages1[2].selfSeconds);
+
+    // Test Case 2
+    // Count the elements of each stage when pulling in batches.
+    auto iter2 = itertools::Iterator::from(v1).enumerate().filter([](std::pair<size_t, int> &val) {
+        return val.first < 10;
+    });
+    auto c2 = iter2.collectPush<std::vector<std::pair<size_t, int>>>();
+    assert(c2.size() == 10U);
+    auto stages2 = iter2.stats().stages();
+    assert(stages2.size() == 3U);
+    assert(stages2[1].name == "enumerate");
+    assert(stages2[1].pulled == 1000U);
+    assert(stages2[2].pulled == 1000U);
+    assert(stages2[2].yielded == 10U);
+    assert(stages2[2].batchCalls > 0U);
+    assert(stages2[2].nextCalls == 0U);
+
+    // Test Case 3
+    // Report both parents of zipped iterators.
+    auto iter3 = itertools::Iterator::from(v1).zip<char>(itertools::Iterator::from(v2).into());
+    auto c3 = iter3.collectPush<std::vector<std::pair<int, char>>>();
+    assert(c3.size() == 300U);
+    auto stages3 = iter3.stats().stages();
+    assert(stages3.size() == 3U);
+    assert(stages3[0].name == "basic");
+    assert(stages3[1].name == "basic");
+    assert(stages3[1].yielded == 300U);
+    assert(stages3[2].name == "zip");
+    assert(stages3[2].yielded == 300U);
+
+    // Test Case 4
+    // Count sources reduced without batches and format the report.
+    auto iter4 = itertools::Iterator::from(v1);
+    assert(iter4.sum().get() == 499500);
+    auto report4 = iter4.stats();
+    assert(report4.stages()[0].yielded == 1000U);
+    std::string text4 = report4.toText();
+    assert(text4.find("basic") != std::string::npos);
+    assert(text4.find("selectivity") != std::string::npos);
+    std::string json4 = report4.toJson();
+    assert(json4.find("\"enabled\": true") != std::string::npos);
+    assert(json4.find("\"name\": \"basic\"") != std::string::npos);
+    assert(json4.find("\"yielded\": 1000") != std::string::npos);
+
+    // Test Case 5
+    // Report the stages before an asynchronous stage while its producer is running.
+    std::vector<int> v5(100000, 1);
+    auto iter5 = itertools::Iterator::from(v5).map<int>([](int &val) { return val + 1; }).async(16);
+    assert(iter5.inner()->next().get() == 2);
+    for (size_t i = 0; i < 100; ++i) {
+        auto stages5 = iter5.stats().stages();
+        assert(stages5.size() == 3U);
+        assert(stages5[1].yielded <= v5.size());
+    }
+    assert(iter5.sum().get() == 2 * 99999);
+    auto stages5 = iter5.stats().stages();
+    assert(stages5[0].yielded == v5.size());
+    assert(stages5[1].name == "map");
+    assert(stages5[1].yielded == v5.size());
+    assert(stages5[2].name == "async");
+    assert(stages5[2].yielded == v5.size());
+
+    // END
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "itertools.hxx"
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Element counting its copies
+ */
+struct Counted {
+    static size_t copies;
+
+    int value;
+
+    Counted(int value) : value(value) {}
+    Counted(Counted const &other) : value(other.value) { ++copies; }
+    Counted(Counted &&other) noexcept = default;
+    Counted &operator=(Counted const &other) {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    Counted &operator=(Counted &&other) noexcept = default;
+};
+
+size_t Counted::copies = 0;
+
+int main(int argc, char *argv[]) {
+    std::vector<int> v1(100000);
+    for (size_t i = 0; i < v1.size(); ++i) {
+        v1[i] = static_cast<int>(i);
+    }
+    itertools::ThreadPool pool(4);
+
+    // Test Case 1
+    // Insert, find and merge keys of the flat hash map.
+    itertools::FlatHashMap<std::string, int> map1;
+    for (int i = 0; i < 1000; ++i) {
+        map1[std::to_string(i % 100)] += i;
+    }
+    assert(map1.size() == 100U);
+    assert(map1.bucketCount() * 3 >= map1.size() * 4);
+    assert(map1.at("7") == 7 * 10 + 100 * 45);
+    assert(map1.find("100") == nullptr);
+    assert(map1.begin()->first == "0");
+    bool thrown1 = false;
+    try {
+        map1.at("100");
+    } catch (std::out_of_range const &) {
+        thrown1 = true;
+    }
+    assert(thrown1);
+
+    itertools::FlatHashMap<std::string, int> other1(4);
+    other1["7"] = 1;
+    other1["new"] = 2;
+    map1.merge(std::move(other1), [](int &value, int &other) { value += other; });
+    assert(map1.size() == 101U);
+    assert(map1.at("7") == 7 * 10 + 100 * 45 + 1);
+    assert(map1.at("new") == 2);
+    assert(other1.empty());
+
+    // Test Case 2
+    // Count and group the values of an iterator by key.
+    auto counts2 = itertools::Iterator::from(v1).countBy<int>([](int &val) { return val % 7; });
+    assert(counts2.size() == 7U);
+    assert(counts2.at(0) == 14286U);
+    assert(counts2.at(6) == 14285U);
+
+    auto groups2 = itertools::Iterator::from(v1)
+                       .filter([](int &val) { return val < 20; })
+                       .groupBy<bool>([](int &val) { return val % 2 == 0; });
+    assert(groups2.size() == 2U);
+    assert(groups2.begin()->first);
+    assert(groups2.at(false).size() == 10U);
+    assert(groups2.at(false)[3] == 7);
+
+    // Test Case 3
+    // Reduce the pairs of a mapped iterator by key.
+    auto sums3 = itertools::Iterator::from(v1)
+                     .map<std::pair<int, long>>([](int &val) { return std::make_pair(val % 10, long(val)); })
+                     .reduceByKey<int>([](std::pair<int, long> &val) { return val.first; },
+                                       [](std::pair<int, long> &acc, std::pair<int, long> &val) {
+                                           acc.second += val.second;
+                                       });
+    assert(sums3.size() == 10U);
+    long total3 = 0;
+    for (auto &entry : sums3) {
+        assert(entry.first == entry.second.first);
+        total3 += entry.second.second;
+    }
+    assert(total3 == 4999950000L);
+    assert(sums3.at(3).second == 10L * 49995000L + 3L * 10000L);
+
+    // Test Case 4
+    // Aggregate static pipelines sequentially and in parallel.
+    auto counts4 = itertools::Iterator::fuse(v1).map([](int &val) { return val % 1000; }).countBy([](int &val) {
+        return val / 10;
+    });
+    assert(counts4.size() == 100U);
+    assert(counts4.at(42) == 1000U);
+
+    auto parallelCounts4 =
+        itertools::Iterator::fuse(v1).map([](int &val) { return val % 1000; }).par(pool).countBy([](int &val) {
+            return val / 10;
+        });
+    assert(parallelCounts4.size() == 100U);
+    for (auto &entry : parallelCounts4) {
+        assert(entry.second == 1000U);
+    }
+
+    auto parallelGroups4 = itertools::Iterator::fuse(v1).par(pool).groupBy([](int &val) { return val % 3; });
+    assert(parallelGroups4.size() == 3U);
+    assert(parallelGroups4.begin()->first == 0);
+    std::vector<int> &group4 = parallelGroups4.at(1);
+    assert(group4.size() == 33333U);
+    for (size_t i = 0; i < group4.size(); ++i) {
+        assert(group4[i] == static_cast<int>(3 * i + 1));
+    }
+
+    auto parallelSums4 =
+        itertools::Iterator::fuse(v1).par(pool).reduceByKey([](int &val) { return val % 2; },
+                                                            [](int &acc, int &val) { acc = std::max(acc, val); });
+    assert(parallelSums4.at(0) == 99998);
+    assert(parallelSums4.at(1) == 99999);
+
+    // Test Case 5
+    // Only grow the buckets when a new key is inserted and don't allow changing the keys.
+    itertools::FlatHashMap<int, int> map5;
+    size_t buckets5 = itertools::FlatHashMap<int, int>::MinBuckets;
+    for (int i = 0; i < 6; ++i) {
+        map5[i] = i;
+    }
+    assert(map5.bucketCount() == buckets5);
+    assert(!map5.tryEmplace(3, 0).second);
+    map5[5] += 1;
+    assert(map5.bucketCount() == buckets5);
+    assert(map5.tryEmplace(6, 6).second);
+    assert(map5.bucketCount() == 2 * buckets5);
+    for (int i = 0; i < 7; ++i) {
+        assert(map5.at(i) == (i == 5 ? 6 : i));
+    }
+    static_assert(std::is_const_v<std::remove_reference_t<decltype(map5.begin()->first)>>);
+
+    // Test Case 6
+    // Move the entries instead of copying them when the table grows.
+    auto groups6 = itertools::Iterator::from(v1)
+                       .filter([](int &val) { return val < 20000; })
+                       .map<Counted>([](int &val) { return Counted(val); })
+                       .groupBy<std::string>([](Counted &val) { return std::to_string(val.value % 5000); });
+    assert(groups6.size() == 5000U);
+    assert(groups6.at("42").size() == 4U);
+    assert(groups6.at("42")[3].value == 15042);
+    assert(Counted::copies == 0U);
+
+    itertools::FlatHashMap<int, std::unique_ptr<int>> map6;
+    for (int i = 0; i < 100; ++i) {
+        map6.tryEmplace(i, std::make_unique<int>(i));
+    }
+    assert(*map6.at(99) == 99);
+    static_assert(std::is_const_v<std::remove_reference_t<decltype((*map6.begin()).first)>>);
+
+    // END
+    return 0;
+}